@@ -134,6 +134,7 @@ template<typename T> class CustomArguments;
 class PropertyCallbackArguments;
 class FunctionCallbackArguments;
 class GlobalHandles;
+class StreamedSource;
 }
 
 
@@ -1030,7 +1031,11 @@ class V8_EXPORT ScriptCompiler {
       BufferOwned
     };
 
-    CachedData() : data(NULL), length(0), buffer_policy(BufferNotOwned) {}
+    CachedData()
+        : data(NULL),
+          length(0),
+          rejected(false),
+          buffer_policy(BufferNotOwned) {}
 
     // If buffer_policy is BufferNotOwned, the caller keeps the ownership of
     // data and guarantees that it stays alive until the CachedData object is
@@ -1043,6 +1048,10 @@ class V8_EXPORT ScriptCompiler {
     // which will be called when V8 no longer needs the data.
     const uint8_t* data;
     int length;
+    // Set when consuming a code cache that does not match the source, the V8
+    // version or the flags, or that is corrupted. The script is then compiled
+    // from scratch and the embedder should discard the cached data.
+    bool rejected;
     BufferPolicy buffer_policy;
 
    private:
@@ -1088,6 +1097,73 @@ class V8_EXPORT ScriptCompiler {
     CachedData* cached_data;
   };
 
+  /**
+   * For streaming incomplete script data to V8. The embedder should implement a
+   * subclass of this class.
+   */
+  class ExternalSourceStream {
+   public:
+    virtual ~ExternalSourceStream() {}
+
+    /**
+     * V8 calls this to request the next chunk of data from the embedder. This
+     * function will be called on a background thread, so it's OK to block and
+     * wait for the data, if the embedder doesn't have data yet. Returns the
+     * length of the data returned. When the data ends, GetMoreData should
+     * return 0. Caller takes ownership of the data.
+     *
+     * When streaming UTF-8 data, multi-byte characters may be split between
+     * data chunks. When streaming two-byte data, the chunks must be split at
+     * character boundaries.
+     *
+     * If the embedder wants to cancel the streaming, they should make the next
+     * GetMoreData call return 0. V8 will interpret it as end of data (and most
+     * probably, parsing will fail). The streaming task will return as soon as
+     * V8 has parsed the data it received so far.
+     */
+    virtual size_t GetMoreData(const uint8_t** src) = 0;
+  };
+
+
+  /**
+   * Source code which can be streamed into V8 in pieces. It will be parsed
+   * while streaming. It can be compiled after the streaming is complete.
+   * StreamedSource must be kept alive while the streaming task is ran (see
+   * ScriptStreamingTask below). StreamedSource takes ownership of the
+   * ExternalSourceStream.
+   */
+  class V8_EXPORT StreamedSource {
+   public:
+    enum Encoding { ONE_BYTE, TWO_BYTE, UTF8 };
+
+    StreamedSource(ExternalSourceStream* source_stream, Encoding encoding);
+    ~StreamedSource();
+
+    // Ownership of the CachedData or its buffers is *not* transferred to the
+    // caller. The CachedData object is alive as long as the StreamedSource
+    // object is alive.
+    const CachedData* GetCachedData() const;
+
+    internal::StreamedSource* impl() const { return impl_; }
+
+   private:
+    // Prevent copying. Not implemented.
+    StreamedSource(const StreamedSource&);
+    StreamedSource& operator=(const StreamedSource&);
+
+    internal::StreamedSource* impl_;
+  };
+
+  /**
+   * A streaming task which the embedder must run on a background thread to
+   * stream scripts into V8. Returned by ScriptCompiler::StartStreamingScript.
+   */
+  class ScriptStreamingTask {
+   public:
+    virtual ~ScriptStreamingTask() {}
+    virtual void Run() = 0;
+  };
+
   enum CompileOptions {
     kNoCompileOptions = 0,
     kProduceParserCache,
@@ -1106,7 +1182,8 @@ class V8_EXPORT ScriptCompiler {
    *
    * Note that when producing cached data, the source must point to NULL for
    * cached data. When consuming cached data, the cached data must have been
-   * produced by the same version of V8.
+   * produced by the same version of V8. A code cache that cannot be used is
+   * marked as rejected and the script is compiled as if there was none.
    *
    * \param source Script source code.
    * \return Compiled script object (context independent; for running it must be
@@ -1130,6 +1207,47 @@ class V8_EXPORT ScriptCompiler {
   static Local<Script> Compile(
       Isolate* isolate, Source* source,
       CompileOptions options = kNoCompileOptions);
+
+  /**
+   * Returns a task which streams script data into V8, or NULL if the script
+   * cannot be streamed (for example, when consuming cached data). In that
+   * case Compile below compiles the full source string as usual. The user is
+   * responsible for running the task on a background thread and deleting it.
+   * When ran, the task starts parsing the script, and it will request data
+   * from the StreamedSource as needed. When ScriptStreamingTask::Run exits,
+   * all data has been streamed and the script can be compiled (see Compile
+   * below).
+   *
+   * This API allows to start the streaming with as little data as possible, and
+   * the remaining data (for example, the ScriptOrigin) is passed to Compile.
+   */
+  static ScriptStreamingTask* StartStreamingScript(
+      Isolate* isolate, StreamedSource* source,
+      CompileOptions options = kNoCompileOptions);
+
+  /**
+   * Compiles a streamed script (bound to current context).
+   *
+   * This can only be called after the streaming has finished
+   * (ScriptStreamingTask has been run). V8 doesn't construct the source string
+   * during streaming, so the embedder needs to pass the full source here.
+   */
+  static Local<Script> Compile(Isolate* isolate, StreamedSource* source,
+                               Handle<String> full_source_string,
+                               const ScriptOrigin& origin);
+
+  /**
+   * Creates a code cache for a script that was compiled with
+   * kProduceCodeCache, after it has been run for a while. Unlike the cache
+   * produced at compile time, it also contains the code of the functions that
+   * have been lazily compiled in the meantime, so that consuming it saves
+   * their compilation as well.
+   *
+   * Inline caches and type feedback collected for the script are cleared in
+   * the process. Returns NULL if the script was not compiled to produce a
+   * code cache. The caller takes ownership of the returned CachedData.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script);
 };
 
 
@@ -4538,6 +4656,16 @@ class V8_EXPORT Isolate {
    */
   void LowMemoryNotification();
 
+  /**
+   * Optional notification that the embedder expects this isolate to stay
+   * idle for a long time. Unlike LowMemoryNotification() no work is done
+   * synchronously. Instead, V8 uses the following IdleNotification() calls
+   * to compact the heap, shrink the new space to its initial size and
+   * release unused memory to the system. IdleNotification() returns true
+   * once this is done.
+   */
+  void IdleForLongTimeNotification();
+
   /**
    * Optional notification that a context has been disposed. V8 uses
    * these notifications to guide the GC heuristic. Returns the number
@@ -4809,6 +4937,10 @@ class V8_EXPORT V8 {
    *   tries to make use of its built-ins.
    * - To avoid unnecessary copies of data, V8 will point directly into the
    *   given data blob, so pretty please keep it around until V8 exit.
+   * - V8 never writes to the data blob. It can be memory-mapped read-only
+   *   from a file, so that its pages are shared between all isolates and
+   *   processes using it, and parts that are not used (such as the debugger
+   *   natives) are never paged in.
    * - Compression of the startup blob might be useful, but needs to
    *   handled entirely on the embedders' side.
    * - The call will abort if the data is invalid.
@@ -4816,6 +4948,19 @@ class V8_EXPORT V8 {
   static void SetNativesDataBlob(StartupData* startup_blob);
   static void SetSnapshotDataBlob(StartupData* startup_blob);
 
+  /**
+   * Create a startup snapshot in a new isolate. If custom_source is given,
+   * it is run in the snapshotted context first, so that contexts created
+   * from the snapshot start out with the global state it set up.
+   *
+   * The result can be passed to SetSnapshotDataBlob in a later process of
+   * the same V8 binary built with external startup data. It may rely on CPU
+   * features of the machine it was created on. Returns { NULL, 0, 0 } if
+   * the script fails to compile or throws. The caller owns the data array
+   * in the result and must release it with delete[].
+   */
+  static StartupData CreateSnapshotDataBlob(const char* custom_source = NULL);
+
   /**
    * Adds a message listener.
    *
@@ -13,6 +13,7 @@
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
 #include "src/assert-scope.h"
+#include "src/background-parsing-task.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
 #include "src/base/utils/random-number-generator.h"
@@ -40,8 +41,10 @@
 #include "src/runtime.h"
 #include "src/runtime-profiler.h"
 #include "src/scanner-character-streams.h"
+#include "src/serialize.h"
 #include "src/simulator.h"
 #include "src/snapshot.h"
+#include "src/snapshot-source-sink.h"
 #include "src/unicode-inl.h"
 #include "src/v8threads.h"
 #include "src/version.h"
@@ -370,6 +373,81 @@ void V8::SetSnapshotDataBlob(StartupData* snapshot_blob) {
 }
 
 
+static bool RunExtraCode(Isolate* isolate, const char* utf8_source) {
+  TryCatch try_catch;
+  Local<String> source_string = String::NewFromUtf8(isolate, utf8_source);
+  ScriptOrigin origin(String::NewFromUtf8(isolate, "<embedded script>"));
+  ScriptCompiler::Source source(source_string, origin);
+  Local<Script> script = ScriptCompiler::Compile(isolate, &source);
+  if (script.IsEmpty()) return false;
+  script->Run();
+  return !try_catch.HasCaught();
+}
+
+
+StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
+  StartupData result = { NULL, 0, 0 };
+  Isolate* isolate = Isolate::New();
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  {
+    Isolate::Scope isolate_scope(isolate);
+    internal_isolate->enable_serializer();
+    // Bootstrap from the natives, even if there is a snapshot to start from.
+    Utils::ApiCheck(i::V8::Initialize(NULL),
+                    "v8::V8::CreateSnapshotDataBlob()",
+                    "Error initializing V8");
+    Persistent<Context> context;
+    {
+      HandleScope handle_scope(isolate);
+      Local<Context> new_context = Context::New(isolate);
+      if (!new_context.IsEmpty()) {
+        context.Reset(isolate, new_context);
+        if (custom_source != NULL) {
+          Context::Scope context_scope(new_context);
+          if (!RunExtraCode(isolate, custom_source)) context.Reset();
+        }
+      }
+    }
+    if (!context.IsEmpty()) {
+      // Make sure all builtin scripts are cached.
+      { i::HandleScope scope(internal_isolate);
+        for (int i = 0; i < i::Natives::GetBuiltinsCount(); i++) {
+          internal_isolate->bootstrapper()->NativesSourceLookup(i);
+        }
+      }
+      // If we don't do this then we end up with a stray root pointing at the
+      // context even after we have disposed of the context.
+      internal_isolate->heap()->CollectAllAvailableGarbage("snapshot");
+      i::Object* raw_context = *v8::Utils::OpenPersistent(context);
+      context.Reset();
+
+      i::List<i::byte> snapshot_data;
+      i::ListSnapshotSink snapshot_sink(&snapshot_data);
+      i::StartupSerializer ser(internal_isolate, &snapshot_sink);
+      ser.SerializeStrongReferences();
+
+      i::List<i::byte> context_data;
+      i::ListSnapshotSink context_sink(&context_data);
+      i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
+      context_ser.Serialize(&raw_context);
+      ser.SerializeWeakReferences();
+
+      i::List<i::byte> blob;
+      i::ListSnapshotSink blob_sink(&blob);
+      i::WriteStartupBlob(snapshot_data, ser, context_data, context_ser,
+                          &blob_sink);
+      char* data = new char[blob.length()];
+      i::MemCopy(data, blob.begin(), blob.length());
+      result.data = data;
+      result.compressed_size = blob.length();
+      result.raw_size = blob.length();
+    }
+  }
+  isolate->Dispose();
+  return result;
+}
+
+
 void V8::SetFatalErrorHandler(FatalErrorCallback that) {
   i::Isolate* isolate = i::Isolate::Current();
   isolate->set_exception_behavior(that);
@@ -1589,7 +1667,10 @@ void ObjectTemplate::SetInternalFieldCount(int value) {
 
 ScriptCompiler::CachedData::CachedData(const uint8_t* data_, int length_,
                                        BufferPolicy buffer_policy_)
-    : data(data_), length(length_), buffer_policy(buffer_policy_) {}
+    : data(data_),
+      length(length_),
+      rejected(false),
+      buffer_policy(buffer_policy_) {}
 
 
 ScriptCompiler::CachedData::~CachedData() {
@@ -1791,6 +1872,8 @@ Local<UnboundScript> ScriptCompiler::CompileUnbound(
       source->cached_data = new CachedData(
           script_data->data(), script_data->length(), CachedData::BufferOwned);
       script_data->ReleaseDataOwnership();
+    } else if (options == kConsumeCodeCache && script_data->rejected()) {
+      source->cached_data->rejected = true;
     }
     delete script_data;
   }
@@ -1813,6 +1896,123 @@ Local<Script> ScriptCompiler::Compile(
 }
 
 
+ScriptCompiler::StreamedSource::StreamedSource(ExternalSourceStream* stream,
+                                               Encoding encoding)
+    : impl_(new i::StreamedSource(stream, encoding)) {}
+
+
+ScriptCompiler::StreamedSource::~StreamedSource() { delete impl_; }
+
+
+const ScriptCompiler::CachedData*
+ScriptCompiler::StreamedSource::GetCachedData() const {
+  return impl_->cached_data.get();
+}
+
+
+ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
+    Isolate* v8_isolate, StreamedSource* source, CompileOptions options) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  if (options == kProduceDataToCache) options = kProduceParserCache;
+  if (options != kNoCompileOptions && options != kProduceParserCache) {
+    // Consuming cached data needs the whole source up front, and code caching
+    // needs the script object; neither is available while streaming.
+    return NULL;
+  }
+  LOG_API(isolate, "ScriptCompiler::StartStreamingScript");
+  return new i::BackgroundParsingTask(source->impl(), options,
+                                      i::FLAG_stack_size, isolate);
+}
+
+
+Local<Script> ScriptCompiler::Compile(Isolate* v8_isolate,
+                                      StreamedSource* v8_source,
+                                      Handle<String> full_source_string,
+                                      const ScriptOrigin& origin) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  i::StreamedSource* source = v8_source->impl();
+  if (source->parser.is_empty()) {
+    // The script was not streamed (see StartStreamingScript); compile it from
+    // the full source instead.
+    Source plain_source(full_source_string, origin);
+    return Compile(v8_isolate, &plain_source);
+  }
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::Compile()", return Local<Script>());
+  LOG_API(isolate, "ScriptCompiler::Compile()");
+  ENTER_V8(isolate);
+  i::SharedFunctionInfo* raw_result = NULL;
+
+  { i::HandleScope scope(isolate);
+    i::Handle<i::String> str = Utils::OpenHandle(*(full_source_string));
+    i::Handle<i::Script> script = isolate->factory()->NewScript(str);
+    if (!origin.ResourceName().IsEmpty()) {
+      script->set_name(*Utils::OpenHandle(*(origin.ResourceName())));
+    }
+    if (!origin.ResourceLineOffset().IsEmpty()) {
+      script->set_line_offset(i::Smi::FromInt(
+          static_cast<int>(origin.ResourceLineOffset()->Value())));
+    }
+    if (!origin.ResourceColumnOffset().IsEmpty()) {
+      script->set_column_offset(i::Smi::FromInt(
+          static_cast<int>(origin.ResourceColumnOffset()->Value())));
+    }
+    if (!origin.ResourceIsSharedCrossOrigin().IsEmpty()) {
+      script->set_is_shared_cross_origin(
+          origin.ResourceIsSharedCrossOrigin() == v8::True(v8_isolate));
+    }
+    source->info->SetScript(script);
+    source->info->SetContext(isolate->global_context());
+
+    EXCEPTION_PREAMBLE(isolate);
+
+    // Do the parsing tasks which need to be done on the main thread. This
+    // also throws the parse error, if any.
+    source->parser->Internalize();
+
+    i::Handle<i::SharedFunctionInfo> result;
+    if (source->info->function() != NULL) {
+      result = i::Compiler::CompileStreamedScript(source->info.get(),
+                                                  str->length());
+    } else {
+      isolate->ReportPendingMessages();
+    }
+    has_pending_exception = result.is_null();
+    EXCEPTION_BAILOUT_CHECK(isolate, Local<Script>());
+    raw_result = *result;
+  }
+  i::Handle<i::SharedFunctionInfo> result(raw_result, isolate);
+  Local<UnboundScript> generic = ToApiHandle<UnboundScript>(result);
+  return generic->BindToCurrentContext();
+}
+
+
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptCompiler::CreateCodeCache()", return NULL);
+  LOG_API(isolate, "ScriptCompiler::CreateCodeCache");
+  ENTER_V8(isolate);
+  DCHECK(shared->is_toplevel());
+  i::Handle<i::Script> script(i::Script::cast(shared->script()));
+  if (!i::FLAG_serialize_toplevel || !script->compiled_for_serialization() ||
+      isolate->debug()->is_loaded()) {
+    return NULL;
+  }
+  i::Handle<i::String> source(i::String::cast(script->source()));
+  i::CodeSerializer::ClearFeedbackForSerialization(isolate, script);
+  i::ScriptData* script_data =
+      i::CodeSerializer::Serialize(isolate, shared, source);
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 Local<Script> Script::Compile(v8::Handle<String> source,
                               v8::ScriptOrigin* origin) {
   i::Handle<i::String> str = Utils::OpenHandle(*source);
@@ -6798,6 +6998,12 @@ void v8::Isolate::LowMemoryNotification() {
 }
 
 
+void v8::Isolate::IdleForLongTimeNotification() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->StartMemoryReducer();
+}
+
+
 int v8::Isolate::ContextDisposedNotification() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   return isolate->heap()->NotifyContextDisposed();
@@ -222,8 +222,8 @@ class AstNode: public ZoneObject {
   }
 
   static int ReserveIdRange(Zone* zone, int n) {
-    int tmp = zone->isolate()->ast_node_id();
-    zone->isolate()->set_ast_node_id(tmp + n);
+    int tmp = zone->ast_node_id();
+    zone->set_ast_node_id(tmp + n);
     return tmp;
   }
 
@@ -199,6 +199,15 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+void OS::AdviseHugePages(void* address, const size_t size) {
+#if defined(MADV_HUGEPAGE)
+  // The advice is only a hint; the kernel falls back to regular pages when
+  // transparent huge pages are disabled or unavailable.
+  madvise(address, size, MADV_HUGEPAGE);
+#endif
+}
+
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
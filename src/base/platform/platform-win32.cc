@@ -821,6 +821,12 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+void OS::AdviseHugePages(void* address, const size_t size) {
+  // Large pages on Windows need to be requested at reservation time and
+  // cannot be committed lazily.
+}
+
+
 void OS::Sleep(int milliseconds) {
   ::Sleep(milliseconds);
 }
@@ -868,9 +874,12 @@ class Win32MemoryMappedFile : public OS::MemoryMappedFile {
 };
 
 
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                 FileMode mode) {
+  bool read_only = mode == READ_ONLY;
   // Open a physical file
-  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE,
+  HANDLE file = CreateFileA(name,
+      read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
   if (file == INVALID_HANDLE_VALUE) return NULL;
 
@@ -878,11 +887,21 @@ OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
 
   // Create a file mapping for the physical file
   HANDLE file_mapping = CreateFileMapping(file, NULL,
-      PAGE_READWRITE, 0, static_cast<DWORD>(size), NULL);
-  if (file_mapping == NULL) return NULL;
+      read_only ? PAGE_READONLY : PAGE_READWRITE, 0,
+      static_cast<DWORD>(size), NULL);
+  if (file_mapping == NULL) {
+    CloseHandle(file);
+    return NULL;
+  }
 
   // Map a view of the file into memory
-  void* memory = MapViewOfFile(file_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  void* memory = MapViewOfFile(file_mapping,
+      read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (memory == NULL) {
+    CloseHandle(file_mapping);
+    CloseHandle(file);
+    return NULL;
+  }
   return new Win32MemoryMappedFile(file, file_mapping, memory, size);
 }
 
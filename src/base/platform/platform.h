@@ -220,6 +220,10 @@ class OS {
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Hint that committed memory should be backed by transparent huge pages.
+  // This is a no-op on platforms without support for it.
+  static void AdviseHugePages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
@@ -246,7 +250,11 @@ class OS {
 
   class MemoryMappedFile {
    public:
-    static MemoryMappedFile* open(const char* name);
+    enum FileMode { READ_ONLY, READ_WRITE };
+    // A read-only mapping can be shared with other processes mapping the same
+    // file. Returns NULL if the file cannot be mapped.
+    static MemoryMappedFile* open(const char* name,
+                                  FileMode mode = READ_WRITE);
     static MemoryMappedFile* create(const char* name, int size, void* initial);
     virtual ~MemoryMappedFile() { }
     virtual void* memory() = 0;
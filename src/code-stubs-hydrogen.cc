@@ -332,6 +332,7 @@ HValue* CodeStubGraphBuilder<FastCloneShallowArrayStub>::BuildCodeStub() {
   Factory* factory = isolate()->factory();
   HValue* undefined = graph()->GetConstantUndefined();
   AllocationSiteMode alloc_site_mode = casted_stub()->allocation_site_mode();
+  PretenureFlag pretenure_flag = casted_stub()->pretenure_flag();
 
   // This stub is very performance sensitive, the generated code must be tuned
   // so that it doesn't build and eager frame.
@@ -358,7 +359,8 @@ HValue* CodeStubGraphBuilder<FastCloneShallowArrayStub>::BuildCodeStub() {
   zero_capacity.Then();
   Push(BuildCloneShallowArrayEmpty(boilerplate,
                                    allocation_site,
-                                   alloc_site_mode));
+                                   alloc_site_mode,
+                                   pretenure_flag));
   zero_capacity.Else();
   IfBuilder if_fixed_cow(this);
   if_fixed_cow.If<HCompareMap>(elements, factory->fixed_cow_array_map());
@@ -366,6 +368,7 @@ HValue* CodeStubGraphBuilder<FastCloneShallowArrayStub>::BuildCodeStub() {
   Push(BuildCloneShallowArrayCow(boilerplate,
                                  allocation_site,
                                  alloc_site_mode,
+                                 pretenure_flag,
                                  FAST_ELEMENTS));
   if_fixed_cow.Else();
   IfBuilder if_fixed(this);
@@ -374,12 +377,14 @@ HValue* CodeStubGraphBuilder<FastCloneShallowArrayStub>::BuildCodeStub() {
   Push(BuildCloneShallowArrayNonEmpty(boilerplate,
                                       allocation_site,
                                       alloc_site_mode,
+                                      pretenure_flag,
                                       FAST_ELEMENTS));
 
   if_fixed.Else();
   Push(BuildCloneShallowArrayNonEmpty(boilerplate,
                                       allocation_site,
                                       alloc_site_mode,
+                                      pretenure_flag,
                                       FAST_DOUBLE_ELEMENTS));
   if_fixed.End();
   if_fixed_cow.End();
@@ -416,9 +421,14 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
   HInstruction* boilerplate = Add<HLoadNamedField>(
       allocation_site, static_cast<HValue*>(NULL), access);
 
+  PretenureFlag pretenure_flag = casted_stub()->pretenure_flag();
+  // Allocation mementos are only ever looked up behind new space objects.
+  bool create_memento =
+      FLAG_allocation_site_pretenuring && pretenure_flag == NOT_TENURED;
+
   int size = JSObject::kHeaderSize + casted_stub()->length() * kPointerSize;
   int object_size = size;
-  if (FLAG_allocation_site_pretenuring) {
+  if (create_memento) {
     size += AllocationMemento::kSize;
   }
 
@@ -436,7 +446,7 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
   HValue* size_in_bytes = Add<HConstant>(size);
 
   HInstruction* object = Add<HAllocate>(size_in_bytes, HType::JSObject(),
-      NOT_TENURED, JS_OBJECT_TYPE);
+      pretenure_flag, JS_OBJECT_TYPE);
 
   for (int i = 0; i < object_size; i += kPointerSize) {
     HObjectAccess access = HObjectAccess::ForObservableJSObjectOffset(i);
@@ -445,8 +455,8 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
             boilerplate, static_cast<HValue*>(NULL), access));
   }
 
-  DCHECK(FLAG_allocation_site_pretenuring || (size == object_size));
-  if (FLAG_allocation_site_pretenuring) {
+  DCHECK(create_memento || (size == object_size));
+  if (create_memento) {
     BuildCreateAllocationMemento(
         object, Add<HConstant>(object_size), allocation_site);
   }
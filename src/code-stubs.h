@@ -655,14 +655,22 @@ class FastNewContextStub V8_FINAL : public HydrogenCodeStub {
 class FastCloneShallowArrayStub : public HydrogenCodeStub {
  public:
   FastCloneShallowArrayStub(Isolate* isolate,
-                            AllocationSiteMode allocation_site_mode)
+                            AllocationSiteMode allocation_site_mode,
+                            PretenureFlag pretenure_flag = NOT_TENURED)
       : HydrogenCodeStub(isolate),
-      allocation_site_mode_(allocation_site_mode) {}
+      allocation_site_mode_(allocation_site_mode),
+      pretenure_flag_(pretenure_flag) {
+    // Allocation mementos are only ever created behind new space objects.
+    DCHECK(pretenure_flag_ == NOT_TENURED ||
+           allocation_site_mode_ == DONT_TRACK_ALLOCATION_SITE);
+  }
 
   AllocationSiteMode allocation_site_mode() const {
     return allocation_site_mode_;
   }
 
+  PretenureFlag pretenure_flag() const { return pretenure_flag_; }
+
   virtual Handle<Code> GenerateCode();
 
   virtual void InitializeInterfaceDescriptor(
@@ -672,12 +680,15 @@ class FastCloneShallowArrayStub : public HydrogenCodeStub {
 
  private:
   AllocationSiteMode allocation_site_mode_;
+  PretenureFlag pretenure_flag_;
 
   class AllocationSiteModeBits: public BitField<AllocationSiteMode, 0, 1> {};
+  class PretenureFlagBits: public BitField<PretenureFlag, 1, 1> {};
   // Ensure data fits within available bits.
   Major MajorKey() const { return FastCloneShallowArray; }
   int NotMissMinorKey() const {
-    return AllocationSiteModeBits::encode(allocation_site_mode_);
+    return AllocationSiteModeBits::encode(allocation_site_mode_) |
+           PretenureFlagBits::encode(pretenure_flag_);
   }
 };
 
@@ -687,13 +698,17 @@ class FastCloneShallowObjectStub : public HydrogenCodeStub {
   // Maximum number of properties in copied object.
   static const int kMaximumClonedProperties = 6;
 
-  FastCloneShallowObjectStub(Isolate* isolate, int length)
-      : HydrogenCodeStub(isolate), length_(length) {
+  FastCloneShallowObjectStub(Isolate* isolate, int length,
+                             PretenureFlag pretenure_flag = NOT_TENURED)
+      : HydrogenCodeStub(isolate),
+        length_(length),
+        pretenure_flag_(pretenure_flag) {
     DCHECK_GE(length_, 0);
     DCHECK_LE(length_, kMaximumClonedProperties);
   }
 
   int length() const { return length_; }
+  PretenureFlag pretenure_flag() const { return pretenure_flag_; }
 
   virtual Handle<Code> GenerateCode() V8_OVERRIDE;
 
@@ -702,9 +717,15 @@ class FastCloneShallowObjectStub : public HydrogenCodeStub {
 
  private:
   int length_;
+  PretenureFlag pretenure_flag_;
 
+  class LengthBits: public BitField<int, 0, 4> {};
+  class PretenureFlagBits: public BitField<PretenureFlag, 4, 1> {};
   Major MajorKey() const { return FastCloneShallowObject; }
-  int NotMissMinorKey() const { return length_; }
+  int NotMissMinorKey() const {
+    return LengthBits::encode(length_) |
+           PretenureFlagBits::encode(pretenure_flag_);
+  }
 
   DISALLOW_COPY_AND_ASSIGN(FastCloneShallowObjectStub);
 };
@@ -33,7 +33,7 @@ namespace internal {
 
 
 ScriptData::ScriptData(const byte* data, int length)
-    : owns_data_(false), data_(data), length_(length) {
+    : owns_data_(false), rejected_(false), data_(data), length_(length) {
   if (!IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment)) {
     byte* copy = NewArray<byte>(length);
     DCHECK(IsAligned(reinterpret_cast<intptr_t>(copy), kPointerAlignment));
@@ -71,6 +71,23 @@ CompilationInfo::CompilationInfo(Isolate* isolate, Zone* zone)
 }
 
 
+CompilationInfo::CompilationInfo(
+    ScriptCompiler::ExternalSourceStream* source_stream,
+    ScriptCompiler::StreamedSource::Encoding encoding, Isolate* isolate,
+    Zone* zone)
+    : flags_(StrictModeField::encode(SLOPPY)),
+      osr_ast_id_(BailoutId::None()),
+      parameter_count_(0),
+      this_has_uses_(true),
+      optimization_id_(-1),
+      ast_value_factory_(NULL),
+      ast_value_factory_owned_(false) {
+  Initialize(isolate, BASE, zone);
+  source_stream_ = source_stream;
+  source_stream_encoding_ = encoding;
+}
+
+
 CompilationInfo::CompilationInfo(Handle<SharedFunctionInfo> shared_info,
                                  Zone* zone)
     : flags_(StrictModeField::encode(SLOPPY) | IsLazy::encode(true)),
@@ -128,6 +145,8 @@ void CompilationInfo::Initialize(Isolate* isolate,
   extension_ = NULL;
   cached_data_ = NULL;
   compile_options_ = ScriptCompiler::kNoCompileOptions;
+  source_stream_ = NULL;
+  source_stream_encoding_ = ScriptCompiler::StreamedSource::ONE_BYTE;
   zone_ = zone;
   deferred_handles_ = NULL;
   code_stub_ = NULL;
@@ -144,7 +163,10 @@ void CompilationInfo::Initialize(Isolate* isolate,
   }
   mode_ = mode;
   abort_due_to_dependency_ = false;
-  if (script_->type()->value() == Script::TYPE_NATIVE) MarkAsNative();
+  // A streamed script has no script object yet; it is never native code.
+  if (!script_.is_null() && script_->type()->value() == Script::TYPE_NATIVE) {
+    MarkAsNative();
+  }
   if (isolate_->debug()->is_active()) MarkAsDebug();
 
   if (!shared_info_.is_null()) {
@@ -391,6 +413,9 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     unoptimized.PrepareForCompilation(info()->scope());
     unoptimized.SetContext(info()->context());
     if (should_recompile) unoptimized.EnableDeoptimizationSupport();
+    if (unoptimized.script()->compiled_for_serialization()) {
+      unoptimized.PrepareForSerializing();
+    }
     bool succeeded = FullCodeGenerator::MakeCode(&unoptimized);
     if (should_recompile) {
       if (!succeeded) return SetLastStatus(FAILED);
@@ -414,13 +439,22 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
       info()->function()->dont_optimize_reason() != kTryFinallyStatement &&
       // TODO(turbofan): Make OSR work and remove this bailout.
       !info()->is_osr()) {
-    compiler::Pipeline pipeline(info());
-    pipeline.GenerateCode();
-    if (!info()->code().is_null()) {
+    Timer t(this, &time_taken_to_create_graph_);
+    compiler::Pipeline* pipeline =
+        new (info()->zone()) compiler::Pipeline(info());
+    if (pipeline->CreateGraph()) {
+      // The remaining phases run in OptimizeGraph and GenerateCode, possibly
+      // on the concurrent recompilation thread.
+      pipeline_ = pipeline;
       return SetLastStatus(SUCCEEDED);
     }
   }
 
+  return CreateHydrogenGraph();
+}
+
+
+OptimizedCompileJob::Status OptimizedCompileJob::CreateHydrogenGraph() {
   if (FLAG_trace_hydrogen) {
     Handle<String> name = info()->function()->debug_name();
     PrintF("-----------------------------------------------------------\n");
@@ -470,12 +504,18 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
   DisallowCodeDependencyChange no_dependency_change;
 
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
-    return last_status();
+  Timer t(this, &time_taken_to_optimize_);
+  if (pipeline_ != NULL) {
+    if (pipeline_->OptimizeGraph()) return SetLastStatus(SUCCEEDED);
+    // Register allocation can still fail for graphs that passed the checks
+    // in CreateGraph. Building the Hydrogen graph needs the main thread, so
+    // the fallback is deferred to GenerateCode.
+    info()->set_bailout_reason(kNoReason);
+    pipeline_ = NULL;
+    fall_back_to_hydrogen_ = true;
+    return SetLastStatus(SUCCEEDED);
   }
 
-  Timer t(this, &time_taken_to_optimize_);
   DCHECK(graph_ != NULL);
   BailoutReason bailout_reason = kNoReason;
 
@@ -492,10 +532,24 @@ OptimizedCompileJob::Status OptimizedCompileJob::OptimizeGraph() {
 
 OptimizedCompileJob::Status OptimizedCompileJob::GenerateCode() {
   DCHECK(last_status() == SUCCEEDED);
-  // TODO(turbofan): Currently everything is done in the first phase.
-  if (!info()->code().is_null()) {
+  if (fall_back_to_hydrogen_) {
+    fall_back_to_hydrogen_ = false;
+    if (CreateHydrogenGraph() != SUCCEEDED) return last_status();
+    if (OptimizeGraph() != SUCCEEDED) return last_status();
+  }
+  if (pipeline_ != NULL) {
+    DisallowJavascriptExecution no_js(isolate());
+    {  // Scope for timer.
+      Timer timer(this, &time_taken_to_codegen_);
+      if (pipeline_->AssembleCode().is_null()) {
+        if (info()->bailout_reason() == kNoReason) {
+          info_->set_bailout_reason(kCodeGenerationFailed);
+        }
+        return AbortOptimization();
+      }
+    }
     RecordOptimizationStats();
-    return last_status();
+    return SetLastStatus(SUCCEEDED);
   }
 
   DCHECK(!info()->HasAbortedDueToDependencyChange());
@@ -685,6 +739,11 @@ MUST_USE_RESULT static MaybeHandle<Code> GetUnoptimizedCodeCommon(
     CompilationInfo* info) {
   VMState<COMPILER> state(info->isolate());
   PostponeInterruptsScope postpone(info->isolate());
+  // Functions of a script that is cached are compiled so that they can be
+  // included in the code cache when it is regenerated after warm-up.
+  if (info->script()->compiled_for_serialization()) {
+    info->PrepareForSerializing();
+  }
   if (!Parser::Parse(info)) return MaybeHandle<Code>();
   info->SetStrictMode(info->function()->strict_mode());
 
@@ -813,8 +872,8 @@ void Compiler::CompileForLiveEdit(Handle<Script> script) {
 }
 
 
-static bool DebuggerWantsEagerCompilation(CompilationInfo* info,
-                                          bool allow_lazy_without_ctx = false) {
+bool Compiler::DebuggerWantsEagerCompilation(CompilationInfo* info,
+                                             bool allow_lazy_without_ctx) {
   return LiveEditFunctionTracker::IsActive(info->isolate()) ||
          (info->isolate()->DebuggerHasBreakPoints() && !allow_lazy_without_ctx);
 }
@@ -834,28 +893,33 @@ static Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
 
   DCHECK(info->is_eval() || info->is_global());
 
-  bool parse_allow_lazy =
-      (info->compile_options() == ScriptCompiler::kConsumeParserCache ||
-       String::cast(script->source())->length() > FLAG_min_preparse_length) &&
-      !DebuggerWantsEagerCompilation(info);
-
-  if (!parse_allow_lazy &&
-      (info->compile_options() == ScriptCompiler::kProduceParserCache ||
-       info->compile_options() == ScriptCompiler::kConsumeParserCache)) {
-    // We are going to parse eagerly, but we either 1) have cached data produced
-    // by lazy parsing or 2) are asked to generate cached data. We cannot use
-    // the existing data, since it won't contain all the symbols we need for
-    // eager parsing. In addition, it doesn't make sense to produce the data
-    // when parsing eagerly. That data would contain all symbols, but no
-    // functions, so it cannot be used to aid lazy parsing later.
-    info->SetCachedData(NULL, ScriptCompiler::kNoCompileOptions);
-  }
-
   Handle<SharedFunctionInfo> result;
 
   { VMState<COMPILER> state(info->isolate());
-    if (!Parser::Parse(info, parse_allow_lazy)) {
-      return Handle<SharedFunctionInfo>::null();
+    // A streamed script has already been parsed on a background thread.
+    if (info->function() == NULL) {
+      bool parse_allow_lazy =
+          (info->compile_options() == ScriptCompiler::kConsumeParserCache ||
+           String::cast(script->source())->length() >
+               FLAG_min_preparse_length) &&
+          !Compiler::DebuggerWantsEagerCompilation(info);
+
+      if (!parse_allow_lazy &&
+          (info->compile_options() == ScriptCompiler::kProduceParserCache ||
+           info->compile_options() == ScriptCompiler::kConsumeParserCache)) {
+        // We are going to parse eagerly, but we either 1) have cached data
+        // produced by lazy parsing or 2) are asked to generate cached data.
+        // We cannot use the existing data, since it won't contain all the
+        // symbols we need for eager parsing. In addition, it doesn't make
+        // sense to produce the data when parsing eagerly. That data would
+        // contain all symbols, but no functions, so it cannot be used to aid
+        // lazy parsing later.
+        info->SetCachedData(NULL, ScriptCompiler::kNoCompileOptions);
+      }
+
+      if (!Parser::Parse(info, parse_allow_lazy)) {
+        return Handle<SharedFunctionInfo>::null();
+      }
     }
 
     FunctionLiteral* lit = info->function();
@@ -997,12 +1061,16 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
     if (FLAG_serialize_toplevel &&
         compile_options == ScriptCompiler::kConsumeCodeCache &&
         !isolate->debug()->is_loaded()) {
-      return CodeSerializer::Deserialize(isolate, *cached_data, source);
-    } else {
-      maybe_result = compilation_cache->LookupScript(
-          source, script_name, line_offset, column_offset,
-          is_shared_cross_origin, context);
+      if (CodeSerializer::Deserialize(isolate, *cached_data, source)
+              .ToHandle(&result)) {
+        return result;
+      }
+      // The cached data was rejected. Fall back to compiling the script.
+      (*cached_data)->Reject();
     }
+    maybe_result = compilation_cache->LookupScript(
+        source, script_name, line_offset, column_offset, is_shared_cross_origin,
+        context);
   }
 
   base::ElapsedTimer timer;
@@ -1035,6 +1103,7 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
     if (FLAG_serialize_toplevel &&
         compile_options == ScriptCompiler::kProduceCodeCache) {
       info.PrepareForSerializing();
+      script->set_compiled_for_serialization(true);
     }
     if (FLAG_use_strict) info.SetStrictMode(STRICT);
 
@@ -1059,6 +1128,20 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
 }
 
 
+Handle<SharedFunctionInfo> Compiler::CompileStreamedScript(
+    CompilationInfo* info, int source_length) {
+  Isolate* isolate = info->isolate();
+  isolate->counters()->total_load_size()->Increment(source_length);
+  isolate->counters()->total_compile_size()->Increment(source_length);
+
+  // The compilation cache is bypassed: the source was parsed before the
+  // script object existed, so there was nothing to look up.
+  Handle<SharedFunctionInfo> result = CompileToplevel(info);
+  if (result.is_null()) isolate->ReportPendingMessages();
+  return result;
+}
+
+
 Handle<SharedFunctionInfo> Compiler::BuildFunctionInfo(
     FunctionLiteral* literal, Handle<Script> script,
     CompilationInfo* outer_info) {
@@ -1083,7 +1166,7 @@ Handle<SharedFunctionInfo> Compiler::BuildFunctionInfo(
   // Debug::FindSharedFunctionInfoInScript.
   bool allow_lazy_without_ctx = literal->AllowsLazyCompilationWithoutContext();
   bool allow_lazy = literal->AllowsLazyCompilation() &&
-      !DebuggerWantsEagerCompilation(&info, allow_lazy_without_ctx);
+      !Compiler::DebuggerWantsEagerCompilation(&info, allow_lazy_without_ctx);
 
   // Generate code
   Handle<ScopeInfo> scope_info;
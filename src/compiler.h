@@ -49,8 +49,12 @@ class ScriptData {
     owns_data_ = false;
   }
 
+  bool rejected() const { return rejected_; }
+  void Reject() { rejected_ = true; }
+
  private:
   bool owns_data_;
+  bool rejected_;
   const byte* data_;
   int length_;
 
@@ -64,6 +68,9 @@ class CompilationInfo {
  public:
   CompilationInfo(Handle<JSFunction> closure, Zone* zone);
   CompilationInfo(Isolate* isolate, Zone* zone);
+  CompilationInfo(ScriptCompiler::ExternalSourceStream* source_stream,
+                  ScriptCompiler::StreamedSource::Encoding encoding,
+                  Isolate* isolate, Zone* zone);
   virtual ~CompilationInfo();
 
   Isolate* isolate() const {
@@ -89,6 +96,12 @@ class CompilationInfo {
     return compile_options_;
   }
   Handle<Context> context() const { return context_; }
+  ScriptCompiler::ExternalSourceStream* source_stream() const {
+    return source_stream_;
+  }
+  ScriptCompiler::StreamedSource::Encoding source_stream_encoding() const {
+    return source_stream_encoding_;
+  }
   BailoutId osr_ast_id() const { return osr_ast_id_; }
   Handle<Code> unoptimized_code() const { return unoptimized_code_; }
   int opt_count() const { return opt_count_; }
@@ -233,6 +246,10 @@ class CompilationInfo {
   void SetContext(Handle<Context> context) {
     context_ = context;
   }
+  void SetScript(Handle<Script> script) {
+    DCHECK(script_.is_null());
+    script_ = script;
+  }
 
   void MarkCompilingForDebugging() {
     flags_ |= IsCompilingForDebugging::encode(true);
@@ -456,6 +473,11 @@ class CompilationInfo {
   ScriptData** cached_data_;
   ScriptCompiler::CompileOptions compile_options_;
 
+  // The source of a script which is parsed while it is being streamed in.
+  // The script object is only created once the streaming has finished.
+  ScriptCompiler::ExternalSourceStream* source_stream_;
+  ScriptCompiler::StreamedSource::Encoding source_stream_encoding_;
+
   // The context of the caller for eval code, and the global context for a
   // global script. Will be a null handle otherwise.
   Handle<Context> context_;
@@ -532,6 +554,11 @@ class CompilationInfoWithZone: public CompilationInfo {
   CompilationInfoWithZone(HydrogenCodeStub* stub, Isolate* isolate)
       : CompilationInfo(stub, isolate, &zone_),
         zone_(isolate) {}
+  CompilationInfoWithZone(ScriptCompiler::ExternalSourceStream* stream,
+                          ScriptCompiler::StreamedSource::Encoding encoding,
+                          Isolate* isolate)
+      : CompilationInfo(stream, encoding, isolate, &zone_),
+        zone_(isolate) {}
 
   // Virtual destructor because a CompilationInfoWithZone has to exit the
   // zone scope and get rid of dependent maps even when the destructor is
@@ -566,8 +593,12 @@ class HGraph;
 class HOptimizedGraphBuilder;
 class LChunk;
 
+namespace compiler {
+class Pipeline;
+}
+
 // A helper class that calls the three compilation phases in
-// Crankshaft and keeps track of its state.  The three phases
+// Crankshaft or TurboFan and keeps track of its state.  The three phases
 // CreateGraph, OptimizeGraph and GenerateAndInstallCode can either
 // fail, bail-out to the full code generator or succeed.  Apart from
 // their return value, the status of the phase last run can be checked
@@ -579,6 +610,8 @@ class OptimizedCompileJob: public ZoneObject {
         graph_builder_(NULL),
         graph_(NULL),
         chunk_(NULL),
+        pipeline_(NULL),
+        fall_back_to_hydrogen_(false),
         last_status_(FAILED),
         awaiting_install_(false) { }
 
@@ -621,12 +654,19 @@ class OptimizedCompileJob: public ZoneObject {
   HOptimizedGraphBuilder* graph_builder_;
   HGraph* graph_;
   LChunk* chunk_;
+  // Set instead of the above when compiling with TurboFan.
+  compiler::Pipeline* pipeline_;
+  // Set when the TurboFan pipeline failed in OptimizeGraph. Hydrogen then
+  // takes over in GenerateCode, back on the main thread.
+  bool fall_back_to_hydrogen_;
   base::TimeDelta time_taken_to_create_graph_;
   base::TimeDelta time_taken_to_optimize_;
   base::TimeDelta time_taken_to_codegen_;
   Status last_status_;
   bool awaiting_install_;
 
+  MUST_USE_RESULT Status CreateHydrogenGraph();
+
   MUST_USE_RESULT Status SetLastStatus(Status status) {
     last_status_ = status;
     return last_status_;
@@ -691,6 +731,17 @@ class Compiler : public AllStatic {
       ScriptCompiler::CompileOptions compile_options,
       NativesFlag is_natives_code);
 
+  // Compile a script which has already been parsed while it was streamed in
+  // (see BackgroundParsingTask). The script object must have been set on the
+  // compilation info.
+  static Handle<SharedFunctionInfo> CompileStreamedScript(CompilationInfo* info,
+                                                          int source_length);
+
+  // Whether the debugger needs all functions to be compiled eagerly, which
+  // rules out lazy parsing.
+  static bool DebuggerWantsEagerCompilation(
+      CompilationInfo* info, bool allow_lazy_without_ctx = false);
+
   // Create a shared function info object (the code may be lazily compiled).
   static Handle<SharedFunctionInfo> BuildFunctionInfo(FunctionLiteral* node,
                                                       Handle<Script> script,
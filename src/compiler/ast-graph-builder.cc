@@ -1294,8 +1294,19 @@ void AstGraphBuilder::VisitCall(Call* expr) {
     environment()->Poke(arg_count + 0, new_receiver);
   }
 
+  // Remember what the call IC has seen at this call site, the inliner uses it
+  // to prioritize call sites and to inline calls through unknown callees.
+  Handle<Object> feedback;
+  if (expr->IsUsingCallFeedbackSlot(isolate()) &&
+      expr->HasCallFeedbackSlot() && !info()->shared_info().is_null()) {
+    FixedArray* vector = info()->shared_info()->feedback_vector();
+    if (expr->CallFeedbackSlot() < vector->length()) {
+      feedback = handle(vector->get(expr->CallFeedbackSlot()), isolate());
+    }
+  }
+
   // Create node to perform the function call.
-  Operator* call = javascript()->Call(args->length() + 2, flags);
+  Operator* call = javascript()->Call(args->length() + 2, flags, feedback);
   Node* value = ProcessArguments(call, args->length() + 2);
   ast_context()->ProduceValueWithLazyBailout(value);
 }
@@ -275,8 +275,26 @@ void CodeGenerator::BuildTranslation(Instruction* instr,
                            Translation::kSelfLiteralId,
                            descriptor->size() - descriptor->parameters_count());
 
+  int input_index = 0;
+  size_t object_index = 0;
   for (int i = 0; i < descriptor->size(); i++) {
-    AddTranslationForOperand(&translation, instr, instr->InputAt(i));
+    if (object_index < descriptor->captured_object_count() &&
+        descriptor->captured_object(object_index).slot == i) {
+      const FrameStateDescriptor::CapturedObject& object =
+          descriptor->captured_object(object_index++);
+      if (object.duplicate_of >= 0) {
+        translation.DuplicateObject(object.duplicate_of);
+        continue;
+      }
+      translation.BeginCapturedObject(object.length);
+      for (int j = 0; j < object.length; j++) {
+        AddTranslationForOperand(&translation, instr,
+                                 instr->InputAt(input_index++));
+      }
+      continue;
+    }
+    AddTranslationForOperand(&translation, instr,
+                             instr->InputAt(input_index++));
   }
 
   deoptimization_states_[deoptimization_id] =
@@ -31,6 +31,29 @@ class ControlOperator : public Operator1<int> {
   int ControlInputCount() const { return parameter(); }
 };
 
+// Heap constants remember whether their object was in new space when the
+// operator was created, so that the instruction selector does not have to
+// dereference the handle on the concurrent recompilation thread. Objects do
+// not move back into new space, so a stale answer is only conservative.
+class HeapConstantOperator : public Operator1<PrintableUnique<Object> > {
+ public:
+  explicit HeapConstantOperator(PrintableUnique<Object> value)
+      : Operator1<PrintableUnique<Object> >(IrOpcode::kHeapConstant,
+                                            Operator::kPure, 0, 1,
+                                            "HeapConstant", value),
+        in_new_space_(IsInNewSpace(value.handle())) {}
+
+  bool InNewSpace() const { return in_new_space_; }
+
+ private:
+  static bool IsInNewSpace(Handle<Object> value) {
+    return value->IsHeapObject() &&
+           HeapObject::cast(*value)->GetHeap()->InNewSpace(*value);
+  }
+
+  bool in_new_space_;
+};
+
 class CallOperator : public Operator1<CallDescriptor*> {
  public:
   CallOperator(CallDescriptor* descriptor, const char* mnemonic)
@@ -117,8 +140,7 @@ class CommonOperatorBuilder {
                           "NumberConstant", value);
   }
   Operator* HeapConstant(PrintableUnique<Object> value) {
-    return new (zone_) Operator1<PrintableUnique<Object> >(
-        IrOpcode::kHeapConstant, Operator::kPure, 0, 1, "HeapConstant", value);
+    return new (zone_) HeapConstantOperator(value);
   }
   Operator* Phi(int arguments) {
     DCHECK(arguments > 0);  // Disallow empty phis.
@@ -148,6 +170,10 @@ class CommonOperatorBuilder {
     return new (zone_) Operator1<int>(IrOpcode::kStateValues, Operator::kPure,
                                       arguments, 1, "StateValues", arguments);
   }
+  Operator* ObjectState(int arguments) {
+    return new (zone_) Operator1<int>(IrOpcode::kObjectState, Operator::kPure,
+                                      arguments, 1, "ObjectState", arguments);
+  }
   Operator* FrameState(BailoutId ast_id) {
     return new (zone_) Operator1<BailoutId>(
         IrOpcode::kFrameState, Operator::kPure, 3, 1, "FrameState", ast_id);
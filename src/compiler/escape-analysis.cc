@@ -0,0 +1,539 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/escape-analysis.h"
+
+#include <algorithm>
+#include <map>
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/generic-node-inl.h"
+#include "src/compiler/graph-inl.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties-inl.h"
+#include "src/compiler/operator-properties-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// The fields of an object literal whose allocation is being replaced, as laid
+// out by the boilerplate the literal is copied from. Also remembers the values
+// computed for the fields at effect phis, and the nodes created on the way so
+// that they can be dropped again if the object turns out to escape.
+class EscapeAnalysis::VirtualObject : public ZoneObject {
+ public:
+  VirtualObject(Node* allocation, Handle<Map> map, int field_count, Zone* zone)
+      : allocation_(allocation),
+        map_(map),
+        names_(field_count, Handle<Name>(), HandleVector::allocator_type(zone)),
+        values_(field_count, NULL, NodeVector::allocator_type(zone)),
+        merged_values_(MergedValueMap::key_compare(),
+                       MergedValueMap::allocator_type(zone)),
+        new_nodes_(NodeVector::allocator_type(zone)) {}
+
+  Node* allocation() const { return allocation_; }
+  Handle<Map> map() const { return map_; }
+  int field_count() const { return static_cast<int>(values_.size()); }
+
+  void InitializeField(int field, Handle<Name> name, Node* value) {
+    names_[field] = name;
+    values_[field] = value;
+  }
+  Node* InitialValueAt(int field) const { return values_[field]; }
+
+  // Returns the field holding the property {name}, or -1 if the object has no
+  // such own property.
+  int FieldOf(Handle<Name> name) const {
+    for (size_t i = 0; i < names_.size(); ++i) {
+      if (*names_[i] == *name) return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  Node** merged_value(Node* effect_phi, int field) {
+    return &merged_values_[std::make_pair(effect_phi->id(), field)];
+  }
+
+  NodeVector* new_nodes() { return &new_nodes_; }
+
+ private:
+  typedef std::vector<Handle<Name>, zone_allocator<Handle<Name> > >
+      HandleVector;
+  typedef std::map<std::pair<NodeId, int>, Node*,
+                   std::less<std::pair<NodeId, int> >,
+                   zone_allocator<std::pair<const std::pair<NodeId, int>,
+                                            Node*> > > MergedValueMap;
+
+  Node* allocation_;
+  Handle<Map> map_;
+  HandleVector names_;
+  NodeVector values_;
+  MergedValueMap merged_values_;
+  NodeVector new_nodes_;
+};
+
+
+class AllocationCollector : public NullNodeVisitor {
+ public:
+  explicit AllocationCollector(Zone* zone)
+      : allocations_(NodeVector::allocator_type(zone)) {}
+
+  GenericGraphVisit::Control Post(Node* node) {
+    if (node->opcode() == IrOpcode::kJSCallRuntime &&
+        OpParameter<Runtime::FunctionId>(node) ==
+            Runtime::kCreateObjectLiteral) {
+      allocations_.push_back(node);
+    }
+    return GenericGraphVisit::CONTINUE;
+  }
+
+  NodeVector* allocations() { return &allocations_; }
+
+ private:
+  NodeVector allocations_;
+};
+
+
+void EscapeAnalysis::Run() {
+  AllocationCollector collector(zone());
+  graph()->VisitNodeInputsFromEnd(&collector);
+  NodeVector* allocations = collector.allocations();
+  for (NodeVectorIter i = allocations->begin(); i != allocations->end(); ++i) {
+    ReplaceAllocation(*i);
+  }
+}
+
+
+static bool Contains(NodeVector* nodes, Node* node) {
+  return std::find(nodes->begin(), nodes->end(), node) != nodes->end();
+}
+
+
+bool EscapeAnalysis::ReplaceAllocation(Node* allocation) {
+  VirtualObject* object = NewVirtualObject(allocation);
+  if (object == NULL) return false;
+
+  // The object escapes unless it is only used as the receiver of named
+  // accesses to its own fields, or recorded in frame states.
+  NodeVector loads(NodeVector::allocator_type(jsgraph_->zone()));
+  NodeVector stores(NodeVector::allocator_type(jsgraph_->zone()));
+  NodeVector state_values(NodeVector::allocator_type(jsgraph_->zone()));
+  for (UseIter i = allocation->uses().begin(); i != allocation->uses().end();
+       ++i) {
+    Node* use = *i;
+    if (NodeProperties::IsEffectEdge(i.edge()) ||
+        NodeProperties::IsControlEdge(i.edge())) {
+      continue;
+    }
+    switch (use->opcode()) {
+      case IrOpcode::kJSLoadNamed: {
+        Handle<Name> name = OpParameter<LoadNamedParameters>(use).name.handle();
+        if (i.edge().index() != 0 || object->FieldOf(name) < 0) return false;
+        loads.push_back(use);
+        break;
+      }
+      case IrOpcode::kJSStoreNamed: {
+        Handle<Name> name = OpParameter<PrintableUnique<Name> >(use).handle();
+        if (i.edge().index() != 0 || object->FieldOf(name) < 0) return false;
+        stores.push_back(use);
+        break;
+      }
+      case IrOpcode::kStateValues:
+        if (!Contains(&state_values, use)) state_values.push_back(use);
+        break;
+      default:
+        return false;
+    }
+  }
+
+  // Taking out the lazy deoptimizations of the accesses must leave every merge
+  // of the exits of the function with at least one input.
+  NodeVector merges(NodeVector::allocator_type(jsgraph_->zone()));
+  NodeVector accesses(loads);
+  accesses.insert(accesses.end(), stores.begin(), stores.end());
+  for (NodeVectorIter i = accesses.begin(); i != accesses.end(); ++i) {
+    Node* merge = NULL;
+    if (!CanRemove(*i, &merge)) return false;
+    if (merge != NULL) merges.push_back(merge);
+  }
+  for (NodeVectorIter i = merges.begin(); i != merges.end(); ++i) {
+    if (std::count(merges.begin(), merges.end(), *i) >= (*i)->InputCount()) {
+      return false;
+    }
+  }
+
+  // Every frame state that mentions the object belongs to the lazy
+  // deoptimization of some node. Those of the removed accesses disappear with
+  // them, the others need to describe the object as it is after the node.
+  NodeVector deopts(NodeVector::allocator_type(jsgraph_->zone()));
+  NodeVector object_states(NodeVector::allocator_type(jsgraph_->zone()));
+  bool escapes = false;
+  for (NodeVectorIter i = state_values.begin();
+       !escapes && i != state_values.end(); ++i) {
+    for (UseIter j = (*i)->uses().begin(); !escapes && j != (*i)->uses().end();
+         ++j) {
+      Node* state = *j;
+      if (state->opcode() != IrOpcode::kFrameState) {
+        escapes = true;
+        break;
+      }
+      for (UseIter k = state->uses().begin(); k != state->uses().end(); ++k) {
+        Node* deopt = *k;
+        if (deopt->opcode() != IrOpcode::kDeoptimize ||
+            NodeProperties::GetControlInput(deopt)->opcode() !=
+                IrOpcode::kLazyDeoptimization) {
+          escapes = true;
+          break;
+        }
+        Node* lazy = NodeProperties::GetControlInput(deopt);
+        Node* node = NodeProperties::GetControlInput(lazy);
+        if (Contains(&accesses, node)) continue;
+        if (Contains(&deopts, deopt)) continue;
+        Node* object_state = ObjectStateAt(object, node);
+        if (object_state == NULL) {
+          escapes = true;
+          break;
+        }
+        deopts.push_back(deopt);
+        object_states.push_back(object_state);
+      }
+    }
+  }
+
+  // Find the value every load observes.
+  NodeVector values(NodeVector::allocator_type(jsgraph_->zone()));
+  for (NodeVectorIter i = loads.begin(); !escapes && i != loads.end(); ++i) {
+    Handle<Name> name = OpParameter<LoadNamedParameters>(*i).name.handle();
+    Node* value = ValueAt(object, NodeProperties::GetEffectInput(*i),
+                          object->FieldOf(name));
+    if (value == NULL) escapes = true;
+    values.push_back(value);
+  }
+
+  if (escapes) {
+    NodeVector* new_nodes = object->new_nodes();
+    for (NodeVectorRIter i = new_nodes->rbegin(); i != new_nodes->rend(); ++i) {
+      if ((*i)->UseCount() == 0) (*i)->RemoveAllInputs();
+    }
+    return false;
+  }
+
+  // Point the surviving frame states at the object state instead.
+  for (size_t i = 0; i < deopts.size(); ++i) {
+    Node* deopt = deopts[i];
+    Node* state = NodeProperties::GetValueInput(deopt, 0);
+    Node* inputs[3];
+    for (int j = 0; j < 3; ++j) {
+      Node* values = state->InputAt(j);
+      inputs[j] = values;
+      if (!Contains(&state_values, values)) continue;
+      int count = values->InputCount();
+      Node** copy = zone()->NewArray<Node*>(count);
+      for (int k = 0; k < count; ++k) {
+        copy[k] = values->InputAt(k) == allocation ? object_states[i]
+                                                   : values->InputAt(k);
+      }
+      inputs[j] = graph()->NewNode(values->op(), count, copy);
+    }
+    deopt->ReplaceInput(0, graph()->NewNode(state->op(), 3, inputs));
+    KillIfUnused(state);
+  }
+
+  // Replace the loads, chasing loads whose value is another removed load.
+  for (size_t i = 0; i < loads.size(); ++i) {
+    Node* value = values[i];
+    for (NodeVectorIter j = std::find(loads.begin(), loads.end(), value);
+         j != loads.end(); j = std::find(loads.begin(), loads.end(), value)) {
+      value = values[j - loads.begin()];
+    }
+    Remove(loads[i], value);
+  }
+  for (NodeVectorIter i = stores.begin(); i != stores.end(); ++i) {
+    Remove(*i, NULL);
+  }
+  Remove(allocation, NULL);
+  return true;
+}
+
+
+// Returns the boilerplate that the literal created by {allocation} is copied
+// from, if the literal was instantiated before.
+static MaybeHandle<JSObject> GetBoilerplate(Node* allocation) {
+  Node* literals = NodeProperties::GetValueInput(allocation, 0);
+  Int32Matcher index(NodeProperties::GetValueInput(allocation, 1));
+  if (literals->opcode() != IrOpcode::kHeapConstant || !index.HasValue()) {
+    return MaybeHandle<JSObject>();
+  }
+  Handle<Object> array = ValueOf<Handle<Object> >(literals->op());
+  if (!array->IsFixedArray() || index.Value() < 0 ||
+      index.Value() >= FixedArray::cast(*array)->length()) {
+    return MaybeHandle<JSObject>();
+  }
+  Object* site = FixedArray::cast(*array)->get(index.Value());
+  if (!site->IsAllocationSite()) return MaybeHandle<JSObject>();
+  Object* boilerplate = AllocationSite::cast(site)->transition_info();
+  if (!boilerplate->IsJSObject()) return MaybeHandle<JSObject>();
+  return handle(JSObject::cast(boilerplate));
+}
+
+
+EscapeAnalysis::VirtualObject* EscapeAnalysis::NewVirtualObject(
+    Node* allocation) {
+  Handle<JSObject> boilerplate;
+  if (!GetBoilerplate(allocation).ToHandle(&boilerplate)) return NULL;
+
+  // Only plain objects with all their properties in-object and without
+  // elements can be described by an object state.
+  Handle<Map> map(boilerplate->map());
+  if (map->instance_type() != JS_OBJECT_TYPE || map->is_dictionary_map() ||
+      boilerplate->elements()->length() != 0 ||
+      boilerplate->properties()->length() != 0) {
+    return NULL;
+  }
+  int field_count = map->NumberOfOwnDescriptors();
+  if (field_count > map->inobject_properties()) return NULL;
+
+  // The deoptimizer materializes the object with the current version of the
+  // boilerplate's map. Stores to the object are not checked against the
+  // field representations and types of that map, so every field has to hold
+  // arbitrary tagged values.
+  Handle<Map> current_map = map;
+  if (map->is_deprecated() && !Map::TryUpdate(map).ToHandle(&current_map)) {
+    return NULL;
+  }
+  if (current_map->NumberOfOwnDescriptors() != field_count) return NULL;
+  DescriptorArray* current_descriptors = current_map->instance_descriptors();
+  for (int i = 0; i < field_count; ++i) {
+    PropertyDetails details = current_descriptors->GetDetails(i);
+    if (details.type() != FIELD || !details.representation().IsTagged() ||
+        !HeapType::Any()->Is(current_descriptors->GetFieldType(i))) {
+      return NULL;
+    }
+  }
+
+  VirtualObject* object =
+      new (zone()) VirtualObject(allocation, current_map, field_count, zone());
+  DescriptorArray* descriptors = map->instance_descriptors();
+  for (int i = 0; i < field_count; ++i) {
+    PropertyDetails details = descriptors->GetDetails(i);
+    if (details.type() != FIELD || details.attributes() != NONE ||
+        !details.representation().IsTagged()) {
+      return NULL;
+    }
+    FieldIndex index = FieldIndex::ForDescriptor(*map, i);
+    if (!index.is_inobject() || index.property_index() >= field_count) {
+      return NULL;
+    }
+    // Nested literals are copied along with the object and would escape.
+    Object* value = boilerplate->RawFastPropertyAt(index);
+    if (!value->IsSmi() && !value->IsHeapNumber() && !value->IsString() &&
+        !value->IsOddball()) {
+      return NULL;
+    }
+    Node* node = jsgraph_->Constant(handle(value, zone()->isolate()));
+    object->InitializeField(index.property_index(),
+                            handle(descriptors->GetKey(i)), node);
+  }
+  return object;
+}
+
+
+// Returns the value of {field} of {object} right after {effect}, or NULL if it
+// cannot be determined.
+Node* EscapeAnalysis::ValueAt(VirtualObject* object, Node* effect, int field) {
+  while (effect != object->allocation()) {
+    switch (effect->opcode()) {
+      case IrOpcode::kJSStoreNamed: {
+        Handle<Name> name =
+            OpParameter<PrintableUnique<Name> >(effect).handle();
+        if (NodeProperties::GetValueInput(effect, 0) == object->allocation() &&
+            object->FieldOf(name) == field) {
+          return NodeProperties::GetValueInput(effect, 1);
+        }
+        break;
+      }
+      case IrOpcode::kEffectPhi: {
+        // Loops could store to the field on the back edge.
+        Node* control = NodeProperties::GetControlInput(effect);
+        if (control->opcode() != IrOpcode::kMerge) return NULL;
+        Node** merged = object->merged_value(effect, field);
+        if (*merged != NULL) return *merged;
+        int count = OperatorProperties::GetEffectInputCount(effect->op());
+        Node** inputs = zone()->NewArray<Node*>(count + 1);
+        bool same = true;
+        for (int i = 0; i < count; ++i) {
+          inputs[i] =
+              ValueAt(object, NodeProperties::GetEffectInput(effect, i), field);
+          if (inputs[i] == NULL) return NULL;
+          if (inputs[i] != inputs[0]) same = false;
+        }
+        if (same) {
+          *merged = inputs[0];
+        } else {
+          inputs[count] = control;
+          *merged = graph()->NewNode(common()->Phi(count), count + 1, inputs);
+          object->new_nodes()->push_back(*merged);
+        }
+        return *merged;
+      }
+      default:
+        break;
+    }
+    if (OperatorProperties::GetEffectInputCount(effect->op()) != 1) {
+      return NULL;
+    }
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return object->InitialValueAt(field);
+}
+
+
+// Returns an ObjectState node describing {object} right after {effect}, or
+// NULL if the value of some field cannot be determined. The inputs are laid
+// out the way the deoptimizer expects a captured object: map, properties,
+// elements and then the in-object fields.
+Node* EscapeAnalysis::ObjectStateAt(VirtualObject* object, Node* effect) {
+  if (!OperatorProperties::HasEffectInput(effect->op())) return NULL;
+  effect = NodeProperties::GetEffectInput(effect);
+  int count = object->field_count() + 3;
+  Node** inputs = zone()->NewArray<Node*>(count);
+  Handle<FixedArray> empty = zone()->isolate()->factory()->empty_fixed_array();
+  inputs[0] = jsgraph_->HeapConstant(object->map());
+  inputs[1] = jsgraph_->HeapConstant(empty);
+  inputs[2] = jsgraph_->HeapConstant(empty);
+  for (int i = 0; i < object->field_count(); ++i) {
+    inputs[i + 3] = ValueAt(object, effect, i);
+    if (inputs[i + 3] == NULL) return NULL;
+  }
+  Node* state = graph()->NewNode(common()->ObjectState(count), count, inputs);
+  object->new_nodes()->push_back(state);
+  return state;
+}
+
+
+// A named access can be removed unless it has a lazy deoptimization that
+// cannot be taken out of the graph. The deoptimization is one input of a merge
+// of the exits of the function, which is returned in {merge}.
+bool EscapeAnalysis::CanRemove(Node* node, Node** merge) {
+  for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+    Node* use = *i;
+    if (!NodeProperties::IsControlEdge(i.edge())) continue;
+    if (use->opcode() == IrOpcode::kContinuation) continue;
+    if (use->opcode() != IrOpcode::kLazyDeoptimization ||
+        use->UseCount() != 1) {
+      return false;
+    }
+    Node* deopt = *use->uses().begin();
+    if (deopt->opcode() != IrOpcode::kDeoptimize || deopt->UseCount() != 1) {
+      return false;
+    }
+    *merge = *deopt->uses().begin();
+    if ((*merge)->opcode() != IrOpcode::kMerge) return false;
+  }
+  return true;
+}
+
+
+// Removes {node} from the graph, replacing its value uses with {value} and
+// wiring its effect and control uses to its own inputs.
+void EscapeAnalysis::Remove(Node* node, Node* value) {
+  Node* continuation = NULL;
+  Node* lazy_deoptimization = NULL;
+  for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+    if (!NodeProperties::IsControlEdge(i.edge())) continue;
+    if ((*i)->opcode() == IrOpcode::kContinuation) {
+      continuation = *i;
+    } else {
+      DCHECK_EQ(IrOpcode::kLazyDeoptimization, (*i)->opcode());
+      lazy_deoptimization = *i;
+    }
+  }
+  if (lazy_deoptimization != NULL) RemoveDeoptimization(lazy_deoptimization);
+  if (continuation != NULL) {
+    continuation->ReplaceUses(NodeProperties::GetControlInput(node));
+    continuation->RemoveAllInputs();
+  }
+
+  Node* effect = NodeProperties::GetEffectInput(node);
+  UseIter iter = node->uses().begin();
+  while (iter != node->uses().end()) {
+    if (NodeProperties::IsEffectEdge(iter.edge())) {
+      iter = iter.UpdateToAndIncrement(effect);
+    } else {
+      DCHECK_NE(NULL, value);
+      iter = iter.UpdateToAndIncrement(value);
+    }
+  }
+  node->RemoveAllInputs();
+}
+
+
+void EscapeAnalysis::RemoveDeoptimization(Node* lazy_deoptimization) {
+  Node* deopt = *lazy_deoptimization->uses().begin();
+  Node* merge = *deopt->uses().begin();
+  for (int i = 0; i < merge->InputCount(); ++i) {
+    if (merge->InputAt(i) == deopt) {
+      RemoveMergeInput(merge, i);
+      break;
+    }
+  }
+  Node* state = NodeProperties::GetValueInput(deopt, 0);
+  deopt->RemoveAllInputs();
+  lazy_deoptimization->RemoveAllInputs();
+  KillIfUnused(state);
+}
+
+
+static void RemoveInput(Node* node, int index) {
+  int count = node->InputCount();
+  for (int i = index; i < count - 1; ++i) {
+    node->ReplaceInput(i, node->InputAt(i + 1));
+  }
+  node->TrimInputCount(count - 1);
+}
+
+
+void EscapeAnalysis::RemoveMergeInput(Node* merge, int index) {
+  int count = merge->InputCount();
+  DCHECK_LT(1, count);
+  NodeVector phis(NodeVector::allocator_type(jsgraph_->zone()));
+  for (UseIter i = merge->uses().begin(); i != merge->uses().end(); ++i) {
+    IrOpcode::Value opcode = (*i)->opcode();
+    if (opcode == IrOpcode::kPhi || opcode == IrOpcode::kEffectPhi) {
+      phis.push_back(*i);
+    }
+  }
+  for (NodeVectorIter i = phis.begin(); i != phis.end(); ++i) {
+    Node* phi = *i;
+    RemoveInput(phi, index);
+    graph()->ChangeOperator(phi, phi->opcode() == IrOpcode::kPhi
+                                     ? common()->Phi(count - 1)
+                                     : common()->EffectPhi(count - 1));
+  }
+  RemoveInput(merge, index);
+  graph()->ChangeOperator(merge, common()->Merge(count - 1));
+}
+
+
+// Disconnects a frame state, or a part of it, once nothing refers to it.
+void EscapeAnalysis::KillIfUnused(Node* node) {
+  if (node->UseCount() != 0) return;
+  NodeVector inputs(NodeVector::allocator_type(jsgraph_->zone()));
+  for (InputIter i = node->inputs().begin(); i != node->inputs().end(); ++i) {
+    inputs.push_back(*i);
+  }
+  node->RemoveAllInputs();
+  for (NodeVectorIter i = inputs.begin(); i != inputs.end(); ++i) {
+    IrOpcode::Value opcode = (*i)->opcode();
+    if (opcode == IrOpcode::kFrameState || opcode == IrOpcode::kStateValues ||
+        opcode == IrOpcode::kObjectState) {
+      KillIfUnused(*i);
+    }
+  }
+}
+}
+}
+}  // namespace v8::internal::compiler
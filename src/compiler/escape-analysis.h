@@ -0,0 +1,54 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_ESCAPE_ANALYSIS_H_
+#define V8_COMPILER_ESCAPE_ANALYSIS_H_
+
+#include "src/compiler/js-graph.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Replaces object literals that never escape the function (including the
+// functions inlined into it) by their fields. Named loads from such an object
+// are replaced by the value last stored to the field along the effect chain,
+// the stores and the allocation itself are removed, and frame states that
+// still refer to the object describe it with an ObjectState node, from which
+// the deoptimizer rematerializes the object.
+class EscapeAnalysis {
+ public:
+  explicit EscapeAnalysis(JSGraph* jsgraph) : jsgraph_(jsgraph) {}
+
+  void Run();
+
+  // Tries to replace the object literal created by {allocation}, returns true
+  // if the allocation was removed from the graph.
+  bool ReplaceAllocation(Node* allocation);
+
+ private:
+  class VirtualObject;
+
+  VirtualObject* NewVirtualObject(Node* allocation);
+  Node* ValueAt(VirtualObject* object, Node* effect, int field);
+  Node* ObjectStateAt(VirtualObject* object, Node* effect);
+
+  bool CanRemove(Node* node, Node** merge);
+  void Remove(Node* node, Node* value);
+  void RemoveDeoptimization(Node* lazy_deoptimization);
+  void RemoveMergeInput(Node* merge, int index);
+  void KillIfUnused(Node* node);
+
+  Graph* graph() { return jsgraph_->graph(); }
+  CommonOperatorBuilder* common() { return jsgraph_->common(); }
+  Zone* zone() { return jsgraph_->zone(); }
+
+  JSGraph* jsgraph_;
+};
+}
+}
+}  // namespace v8::internal::compiler
+
+#endif  // V8_COMPILER_ESCAPE_ANALYSIS_H_
@@ -19,11 +19,12 @@ template <class B, class S>
 GenericNode<B, S>::GenericNode(GenericGraphBase* graph, int input_count)
     : BaseClass(graph->zone()),
       input_count_(input_count),
-      has_appendable_inputs_(false),
+      inputs_(reinterpret_cast<Input*>(this + 1)),
       use_count_(0),
+      reserved_input_count_(input_count),
       first_use_(NULL),
       last_use_(NULL) {
-  inputs_.static_ = reinterpret_cast<Input*>(this + 1), AssignUniqueID(graph);
+  AssignUniqueID(graph);
 }
 
 template <class B, class S>
@@ -139,25 +140,26 @@ void GenericNode<B, S>::Input::Update(GenericNode<B, S>* new_to) {
 
 template <class B, class S>
 void GenericNode<B, S>::EnsureAppendableInputs(Zone* zone) {
-  if (!has_appendable_inputs_) {
-    void* deque_buffer = zone->New(sizeof(InputDeque));
-    InputDeque* deque = new (deque_buffer) InputDeque(ZoneInputAllocator(zone));
-    for (int i = 0; i < input_count_; ++i) {
-      deque->push_back(inputs_.static_[i]);
-    }
-    inputs_.appendable_ = deque;
-    has_appendable_inputs_ = true;
+  if (input_count_ < reserved_input_count_) return;
+  // Grow (or initially move out) the input buffer. The old buffer is left to
+  // the zone; the {Use} records only refer to inputs by index, so copying
+  // the {Input} records keeps all use lists intact.
+  int new_reserved_input_count = std::max(4, 2 * input_count_);
+  Input* new_inputs = zone->NewArray<Input>(new_reserved_input_count);
+  for (int i = 0; i < input_count_; ++i) {
+    new_inputs[i] = inputs_[i];
   }
+  inputs_ = new_inputs;
+  reserved_input_count_ = new_reserved_input_count;
 }
 
 template <class B, class S>
 void GenericNode<B, S>::AppendInput(Zone* zone, GenericNode<B, S>* to_append) {
   EnsureAppendableInputs(zone);
   Use* new_use = new (zone) Use;
-  Input new_input;
-  new_input.to = to_append;
-  new_input.use = new_use;
-  inputs_.appendable_->push_back(new_input);
+  Input* new_input = inputs_ + input_count_;
+  new_input->to = to_append;
+  new_input->use = new_use;
   new_use->input_index = input_count_;
   new_use->from = this;
   to_append->AppendUse(new_use);
@@ -5,8 +5,6 @@
 #ifndef V8_COMPILER_GENERIC_NODE_H_
 #define V8_COMPILER_GENERIC_NODE_H_
 
-#include <deque>
-
 #include "src/v8.h"
 
 #include "src/compiler/operator.h"
@@ -120,11 +118,8 @@ class GenericNode : public B {
   void EnsureAppendableInputs(Zone* zone);
 
   Input* GetInputRecordPtr(int index) const {
-    if (has_appendable_inputs_) {
-      return &((*inputs_.appendable_)[index]);
-    } else {
-      return inputs_.static_ + index;
-    }
+    DCHECK(index < reserved_input_count_);
+    return inputs_ + index;
   }
 
   void AppendUse(Use* use);
@@ -137,21 +132,16 @@ class GenericNode : public B {
  private:
   void AssignUniqueID(GenericGraphBase* graph);
 
-  typedef zone_allocator<Input> ZoneInputAllocator;
-  typedef std::deque<Input, ZoneInputAllocator> InputDeque;
-
   NodeId id_;
-  int input_count_ : 31;
-  bool has_appendable_inputs_ : 1;
-  union {
-    // When a node is initially allocated, it uses a static buffer to hold its
-    // inputs under the assumption that the number of outputs will not increase.
-    // When the first input is appended, the static buffer is converted into a
-    // deque to allow for space-efficient growing.
-    Input* static_;
-    InputDeque* appendable_;
-  } inputs_;
+  int input_count_;
+  // When a node is initially allocated, it uses a static buffer directly
+  // behind the node to hold its inputs under the assumption that the number
+  // of inputs will not increase. When the first input is appended, the inputs
+  // are moved to a separate zone buffer which grows by doubling. Either way
+  // the inputs are contiguous, so input access is a single indexed load.
+  Input* inputs_;
   int use_count_;
+  int reserved_input_count_;
   Use* first_use_;
   Use* last_use_;
 
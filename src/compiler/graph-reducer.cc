@@ -13,7 +13,11 @@ namespace internal {
 namespace compiler {
 
 GraphReducer::GraphReducer(Graph* graph)
-    : graph_(graph), reducers_(Reducers::allocator_type(graph->zone())) {}
+    : graph_(graph),
+      reducers_(Reducers::allocator_type(graph->zone())),
+      state_(States::allocator_type(graph->zone())),
+      stack_(Stack::allocator_type(graph->zone())),
+      revisit_(Revisits::allocator_type(graph->zone())) {}
 
 
 static bool NodeIdIsLessThan(const Node* node, NodeId id) {
@@ -22,13 +26,40 @@ static bool NodeIdIsLessThan(const Node* node, NodeId id) {
 
 
 void GraphReducer::ReduceNode(Node* node) {
+  DCHECK(stack_.empty());
+  DCHECK(revisit_.empty());
+  // Start from a clean slate, so that every node reachable from {node} is
+  // reduced (at least) once per call.
+  state_.assign(graph()->NodeCount(), kUnvisited);
+  Push(node);
+  for (;;) {
+    if (!stack_.empty()) {
+      // Process the node on the top of the stack, potentially pushing more or
+      // popping the node off the stack.
+      ReduceTop();
+    } else if (!revisit_.empty()) {
+      // If the stack becomes empty, revisit any nodes in the revisit queue.
+      Node* const node = revisit_.back();
+      revisit_.pop_back();
+      if (GetState(node) == kRevisit) Push(node);
+    } else {
+      break;
+    }
+  }
+  DCHECK(stack_.empty());
+  DCHECK(revisit_.empty());
+}
+
+
+void GraphReducer::ReduceGraph() { ReduceNode(graph()->end()); }
+
+
+Reduction GraphReducer::Reduce(Node* node) {
   Reducers::iterator skip = reducers_.end();
   static const unsigned kMaxAttempts = 16;
-  bool reduce = true;
+  bool changed = false;
   for (unsigned attempts = 0; attempts <= kMaxAttempts; ++attempts) {
-    if (!reduce) return;
-    reduce = false;  // Assume we don't need to rerun any reducers.
-    int before = graph_->NodeCount();
+    bool reduce = false;
     for (Reducers::iterator i = reducers_.begin(); i != reducers_.end(); ++i) {
       if (i == skip) continue;  // Skip this reducer.
       Reduction reduction = (*i)->Reduce(node);
@@ -40,51 +71,135 @@ void GraphReducer::ReduceNode(Node* node) {
         // Rerun all the reducers except the current one for this node,
         // as now there may be more opportunities for reduction.
         reduce = true;
+        changed = true;
         skip = i;
         break;
       } else {
-        if (node == graph_->start()) graph_->SetStart(replacement);
-        if (node == graph_->end()) graph_->SetEnd(replacement);
-        // If {node} was replaced by an old node, unlink {node} and assume that
-        // {replacement} was already reduced and finish.
-        if (replacement->id() < before) {
-          node->RemoveAllInputs();
-          node->ReplaceUses(replacement);
-          return;
-        }
-        // Otherwise, {node} was replaced by a new node. Replace all old uses of
-        // {node} with {replacement}. New nodes created by this reduction can
-        // use {node}.
-        node->ReplaceUsesIf(
-            std::bind2nd(std::ptr_fun(&NodeIdIsLessThan), before), replacement);
-        // Unlink {node} if it's no longer used.
-        if (node->uses().empty()) node->RemoveAllInputs();
-        // Rerun all the reductions on the {replacement}.
-        skip = reducers_.end();
-        node = replacement;
-        reduce = true;
-        break;
+        // {node} was replaced by another node.
+        return reduction;
       }
     }
+    if (!reduce) break;
   }
+  return changed ? Reducer::Changed(node) : Reducer::NoChange();
 }
 
 
-// A helper class to reuse the node traversal algorithm.
-struct GraphReducerVisitor V8_FINAL : public NullNodeVisitor {
-  explicit GraphReducerVisitor(GraphReducer* reducer) : reducer_(reducer) {}
-  GenericGraphVisit::Control Post(Node* node) {
-    reducer_->ReduceNode(node);
-    return GenericGraphVisit::CONTINUE;
+void GraphReducer::ReduceTop() {
+  NodeState& entry = stack_.back();
+  Node* node = entry.node;
+
+  // Recurse on the next input that was not reduced yet, if any. Note that
+  // {entry} is invalidated by pushing onto the stack.
+  for (int i = entry.input_index; i < node->InputCount(); ++i) {
+    Node* input = node->InputAt(i);
+    entry.input_index = i + 1;
+    if (input != NULL && Recurse(input)) return;
+  }
+
+  // Remember the max node id before reduction.
+  NodeId const max_id = graph()->NodeCount() - 1;
+
+  // All inputs should be visited or on stack. Apply reductions to node.
+  Reduction reduction = Reduce(node);
+
+  // If there was no reduction, pop {node} and continue.
+  if (!reduction.Changed()) {
+    stack_.pop_back();
+    SetState(node, kVisited);
+    return;
+  }
+
+  // Check if the reduction is an in-place update of the {node}.
+  Node* const replacement = reduction.replacement();
+  if (replacement == node) {
+    // In-place update of {node}, may need to recurse on an input.
+    for (int i = 0; i < node->InputCount(); ++i) {
+      Node* input = node->InputAt(i);
+      entry.input_index = i + 1;
+      if (input != NULL && Recurse(input)) return;
+    }
   }
-  GraphReducer* reducer_;
-};
 
+  // After reducing the node, pop it off the stack.
+  stack_.pop_back();
+  SetState(node, kVisited);
 
-void GraphReducer::ReduceGraph() {
-  GraphReducerVisitor visitor(this);
-  // Perform a post-order reduction of all nodes starting from the end.
-  graph()->VisitNodeInputsFromEnd(&visitor);
+  // Revisit all uses of the node.
+  RevisitUses(node);
+
+  // Check if we have a new replacement.
+  if (replacement != node) Replace(node, replacement, max_id);
+}
+
+
+void GraphReducer::Replace(Node* node, Node* replacement, int max_id) {
+  if (node == graph()->start()) graph()->SetStart(replacement);
+  if (node == graph()->end()) graph()->SetEnd(replacement);
+  if (replacement->id() <= max_id) {
+    // {replacement} is an old node, so unlink {node} and assume that
+    // {replacement} was already reduced. Its new uses need to be revisited.
+    node->RemoveAllInputs();
+    node->ReplaceUses(replacement);
+    RevisitUses(replacement);
+  } else {
+    // Replace all old uses of {node} with {replacement}, but allow new nodes
+    // created by this reduction to use {node}.
+    node->ReplaceUsesIf(
+        std::bind2nd(std::ptr_fun(&NodeIdIsLessThan), max_id + 1),
+        replacement);
+    // Unlink {node} if it's no longer used.
+    if (node->uses().empty()) node->RemoveAllInputs();
+    // If there was a replacement, reduce it after popping {node}.
+    Recurse(replacement);
+  }
+}
+
+
+GraphReducer::State GraphReducer::GetState(Node* node) {
+  NodeId id = node->id();
+  if (id >= static_cast<NodeId>(state_.size())) return kUnvisited;
+  return state_[id];
+}
+
+
+void GraphReducer::SetState(Node* node, State state) {
+  NodeId id = node->id();
+  if (id >= static_cast<NodeId>(state_.size())) {
+    state_.resize(graph()->NodeCount(), kUnvisited);
+  }
+  state_[id] = state;
+}
+
+
+void GraphReducer::Push(Node* node) {
+  DCHECK(GetState(node) != kOnStack);
+  SetState(node, kOnStack);
+  NodeState entry = {node, 0};
+  stack_.push_back(entry);
+}
+
+
+bool GraphReducer::Recurse(Node* node) {
+  State state = GetState(node);
+  if (state == kOnStack || state == kVisited) return false;
+  Push(node);
+  return true;
+}
+
+
+void GraphReducer::Revisit(Node* node) {
+  if (GetState(node) == kVisited) {
+    SetState(node, kRevisit);
+    revisit_.push_back(node);
+  }
+}
+
+
+void GraphReducer::RevisitUses(Node* node) {
+  for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+    if (*i != node) Revisit(*i);
+  }
 }
 
 
@@ -6,6 +6,7 @@
 #define V8_COMPILER_GRAPH_REDUCER_H_
 
 #include <list>
+#include <vector>
 
 #include "src/zone-allocator.h"
 
@@ -50,7 +51,10 @@ class Reducer {
 };
 
 
-// Performs an iterative reduction of a node graph.
+// Performs an iterative reduction of a node graph until a fixpoint is
+// reached. Nodes are reduced in post-order using an explicit stack; whenever a
+// node changes, only its (already reduced) uses are queued for revisiting.
+// Cycles through phis and loops are cut at nodes that are still on the stack.
 class GraphReducer V8_FINAL {
  public:
   explicit GraphReducer(Graph* graph);
@@ -59,16 +63,44 @@ class GraphReducer V8_FINAL {
 
   void AddReducer(Reducer* reducer) { reducers_.push_back(reducer); }
 
-  // Reduce a single node.
+  // Reduce a single node and everything reachable from it.
   void ReduceNode(Node* node);
   // Reduce the whole graph.
   void ReduceGraph();
 
  private:
+  enum State { kUnvisited, kRevisit, kOnStack, kVisited };
+
+  struct NodeState {
+    Node* node;
+    int input_index;
+  };
+
   typedef std::list<Reducer*, zone_allocator<Reducer*> > Reducers;
+  typedef std::vector<State, zone_allocator<State> > States;
+  typedef std::vector<NodeState, zone_allocator<NodeState> > Stack;
+  typedef std::vector<Node*, zone_allocator<Node*> > Revisits;
+
+  // Runs all reducers on {node} until none of them applies any more.
+  Reduction Reduce(Node* node);
+  // Processes the node on top of the stack, either recursing on its inputs
+  // or reducing it.
+  void ReduceTop();
+  // Replaces {node} with {replacement} in the graph.
+  void Replace(Node* node, Node* replacement, int max_id);
+
+  State GetState(Node* node);
+  void SetState(Node* node, State state);
+  void Push(Node* node);
+  bool Recurse(Node* node);
+  void Revisit(Node* node);
+  void RevisitUses(Node* node);
 
   Graph* graph_;
   Reducers reducers_;
+  States state_;
+  Stack stack_;
+  Revisits revisit_;
 };
 }
 }
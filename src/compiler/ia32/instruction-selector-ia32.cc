@@ -27,12 +27,12 @@ class IA32OperandGenerator V8_FINAL : public OperandGenerator {
       case IrOpcode::kNumberConstant:
       case IrOpcode::kExternalConstant:
         return true;
-      case IrOpcode::kHeapConstant: {
+      case IrOpcode::kHeapConstant:
         // Constants in new space cannot be used as immediates in V8 because
         // the GC does not scan code objects when collecting the new generation.
-        Handle<HeapObject> value = ValueOf<Handle<HeapObject> >(node->op());
-        return !isolate()->heap()->InNewSpace(*value);
-      }
+        // The operator records this, since the handle must not be
+        // dereferenced on the concurrent recompilation thread.
+        return !static_cast<HeapConstantOperator*>(node->op())->InNewSpace();
       default:
         return false;
     }
@@ -502,6 +502,7 @@ void InstructionSelector::VisitNode(Node* node) {
       return VisitCall(node, NULL, NULL);
     case IrOpcode::kFrameState:
     case IrOpcode::kStateValues:
+    case IrOpcode::kObjectState:
       return;
     case IrOpcode::kLoad: {
       MachineType load_rep = OpParameter<MachineType>(node);
@@ -1007,6 +1008,36 @@ static InstructionOperand* UseOrImmediate(OperandGenerator* g, Node* input) {
 }
 
 
+// Adds the values of a StateValues node, which start at frame slot {slot}, to
+// the inputs of a deoptimization. Objects whose allocation was removed by
+// escape analysis are expanded into their fields the first time they occur,
+// and refer back to that occurrence afterwards.
+static void AddStateValues(OperandGenerator* g, Node* values, int slot,
+                           FrameStateDescriptor* descriptor,
+                           std::vector<Node*>* captured,
+                           std::vector<InstructionOperand*>* inputs) {
+  for (int i = 0; i < values->InputCount(); i++) {
+    Node* value = values->InputAt(i);
+    if (value->opcode() != IrOpcode::kObjectState) {
+      inputs->push_back(UseOrImmediate(g, value));
+      continue;
+    }
+    std::vector<Node*>::iterator first =
+        std::find(captured->begin(), captured->end(), value);
+    if (first != captured->end()) {
+      descriptor->AddDuplicatedObject(
+          slot + i, static_cast<int>(first - captured->begin()));
+    } else {
+      descriptor->AddCapturedObject(slot + i, value->InputCount());
+      for (int j = 0; j < value->InputCount(); j++) {
+        inputs->push_back(UseOrImmediate(g, value->InputAt(j)));
+      }
+    }
+    captured->push_back(value);
+  }
+}
+
+
 void InstructionSelector::VisitDeoptimize(Node* deopt) {
   DCHECK(deopt->op()->opcode() == IrOpcode::kDeoptimize);
   Node* state = deopt->InputAt(0);
@@ -1023,23 +1054,20 @@ void InstructionSelector::VisitDeoptimize(Node* deopt) {
   Node* stack = state->InputAt(2);
   int stack_count = OpParameter<int>(stack);
 
+  FrameStateDescriptor* descriptor = new (instruction_zone())
+      FrameStateDescriptor(ast_id, parameters_count, locals_count, stack_count,
+                           instruction_zone());
+
   OperandGenerator g(this);
   std::vector<InstructionOperand*> inputs;
+  std::vector<Node*> captured;
   inputs.reserve(parameters_count + locals_count + stack_count);
-  for (int i = 0; i < parameters_count; i++) {
-    inputs.push_back(UseOrImmediate(&g, parameters->InputAt(i)));
-  }
-  for (int i = 0; i < locals_count; i++) {
-    inputs.push_back(UseOrImmediate(&g, locals->InputAt(i)));
-  }
-  for (int i = 0; i < stack_count; i++) {
-    inputs.push_back(UseOrImmediate(&g, stack->InputAt(i)));
-  }
-
-  FrameStateDescriptor* descriptor = new (instruction_zone())
-      FrameStateDescriptor(ast_id, parameters_count, locals_count, stack_count);
+  AddStateValues(&g, parameters, 0, descriptor, &captured, &inputs);
+  AddStateValues(&g, locals, parameters_count, descriptor, &captured, &inputs);
+  AddStateValues(&g, stack, parameters_count + locals_count, descriptor,
+                 &captured, &inputs);
 
-  DCHECK_EQ(descriptor->size(), inputs.size());
+  DCHECK_EQ(descriptor->input_count(), inputs.size());
 
   int deoptimization_id = sequence()->AddDeoptimizationEntry(descriptor);
   Emit(kArchDeoptimize | MiscField::encode(deoptimization_id), 0, NULL,
@@ -697,12 +697,23 @@ class Constant V8_FINAL {
 
 class FrameStateDescriptor : public ZoneObject {
  public:
+  // A slot of the frame holding an object that was never allocated and is
+  // materialized by the deoptimizer, either from the next {length} inputs of
+  // the deoptimization, or as the same object as the captured object with
+  // index {duplicate_of}.
+  struct CapturedObject {
+    int slot;
+    int length;
+    int duplicate_of;
+  };
+
   FrameStateDescriptor(BailoutId bailout_id, int parameters_count,
-                       int locals_count, int stack_count)
+                       int locals_count, int stack_count, Zone* zone)
       : bailout_id_(bailout_id),
         parameters_count_(parameters_count),
         locals_count_(locals_count),
-        stack_count_(stack_count) {}
+        stack_count_(stack_count),
+        captured_objects_(CapturedObjects::allocator_type(zone)) {}
 
   BailoutId bailout_id() const { return bailout_id_; }
   int parameters_count() { return parameters_count_; }
@@ -711,11 +722,41 @@ class FrameStateDescriptor : public ZoneObject {
 
   int size() { return parameters_count_ + locals_count_ + stack_count_; }
 
+  // Captured objects must be added in the order of their slots.
+  void AddCapturedObject(int slot, int length) {
+    CapturedObject object = {slot, length, -1};
+    captured_objects_.push_back(object);
+  }
+  void AddDuplicatedObject(int slot, int duplicate_of) {
+    CapturedObject object = {slot, 0, duplicate_of};
+    captured_objects_.push_back(object);
+  }
+  size_t captured_object_count() const { return captured_objects_.size(); }
+  const CapturedObject& captured_object(size_t index) const {
+    return captured_objects_[index];
+  }
+
+  // The number of inputs to the deoptimization, including the fields of the
+  // captured objects.
+  int input_count() const {
+    int count = parameters_count_ + locals_count_ + stack_count_;
+    for (size_t i = 0; i < captured_objects_.size(); ++i) {
+      // A captured object takes {length} inputs instead of one, a duplicate
+      // takes none.
+      count += captured_objects_[i].length - 1;
+    }
+    return count;
+  }
+
  private:
+  typedef std::vector<CapturedObject, zone_allocator<CapturedObject> >
+      CapturedObjects;
+
   BailoutId bailout_id_;
   int parameters_count_;
   int locals_count_;
   int stack_count_;
+  CapturedObjects captured_objects_;
 };
 
 OStream& operator<<(OStream& os, const Constant& constant);
@@ -736,7 +777,7 @@ typedef std::vector<FrameStateDescriptor*,
 // Represents architecture-specific generated code before, during, and after
 // register allocation.
 // TODO(titzer): s/IsDouble/IsFloat64/
-class InstructionSequence V8_FINAL {
+class InstructionSequence V8_FINAL : public ZoneObject {
  public:
   InstructionSequence(Linkage* linkage, Graph* graph, Schedule* schedule)
       : graph_(graph),
@@ -758,6 +799,10 @@ class InstructionSequence V8_FINAL {
 
   int ValueCount() const { return graph_->NodeCount(); }
 
+  int InstructionCount() const {
+    return static_cast<int>(instructions_.size());
+  }
+
   int BasicBlockCount() const {
     return static_cast<int>(schedule_->rpo_order()->size());
   }
@@ -8,6 +8,7 @@
 #include "src/compiler/js-generic-lowering.h"
 #include "src/compiler/machine-operator.h"
 #include "src/compiler/node-aux-data-inl.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties-inl.h"
 #include "src/unique.h"
 
@@ -535,10 +536,123 @@ Node* JSGenericLowering::LowerJSCallFunction(Node* node) {
 
 Node* JSGenericLowering::LowerJSCallRuntime(Node* node) {
   Runtime::FunctionId function = OpParameter<Runtime::FunctionId>(node);
+  if (function == Runtime::kCreateObjectLiteral &&
+      TryReplaceWithFastCloneShallowObject(node)) {
+    return node;
+  }
+  if (function == Runtime::kCreateArrayLiteral &&
+      TryReplaceWithFastCloneShallowArray(node)) {
+    return node;
+  }
   int arity = OperatorProperties::GetValueInputCount(node->op());
   ReplaceWithRuntimeCall(node, function, arity);
   return node;
 }
+
+
+// Returns the heap constant that is the given value input of the node, or a
+// null handle if that input is not a heap constant.
+static Handle<Object> HeapConstantInput(Node* node, int index) {
+  Node* input = NodeProperties::GetValueInput(node, index);
+  if (input->opcode() != IrOpcode::kHeapConstant) return Handle<Object>();
+  return OpParameter<PrintableUnique<Object> >(input).handle();
+}
+
+
+// Literal creation calls take the literals array, the literal index, the
+// constant properties or elements and the flags as value inputs. The
+// allocation site recorded in the literals array decides whether the copy of
+// the boilerplate is allocated in new space or directly in old space.
+PretenureFlag JSGenericLowering::LiteralPretenureFlag(Node* node) {
+  if (!FLAG_allocation_site_pretenuring) return NOT_TENURED;
+  Handle<Object> literals = HeapConstantInput(node, 0);
+  Int32Matcher literal_index(NodeProperties::GetValueInput(node, 1));
+  if (literals.is_null() || !literals->IsFixedArray() ||
+      !literal_index.HasValue()) {
+    return NOT_TENURED;
+  }
+  Object* site = FixedArray::cast(*literals)->get(literal_index.Value());
+  if (!site->IsAllocationSite()) return NOT_TENURED;
+  return AllocationSite::cast(site)->GetPretenureMode();
+}
+
+
+// Mirrors the conditions under which full-codegen uses the same stub, see
+// ObjectLiteral::depth() and ObjectLiteral::may_store_doubles().
+bool JSGenericLowering::TryReplaceWithFastCloneShallowObject(Node* node) {
+  if (isolate()->serializer_enabled()) return false;
+  Int32Matcher flags(NodeProperties::GetValueInput(node, 3));
+  if (!flags.Is(ObjectLiteral::kFastElements)) return false;
+  Handle<Object> constants = HeapConstantInput(node, 2);
+  if (constants.is_null() || !constants->IsFixedArray()) return false;
+  Handle<FixedArray> constant_properties = Handle<FixedArray>::cast(constants);
+  int properties_count = constant_properties->length() / 2;
+  if (properties_count > FastCloneShallowObjectStub::kMaximumClonedProperties) {
+    return false;
+  }
+  for (int i = 0; i < properties_count; i++) {
+    Object* key = constant_properties->get(i * 2);
+    Object* value = constant_properties->get(i * 2 + 1);
+    if (key->IsNumber() || value->IsFixedArray()) return false;
+    if (FLAG_track_double_fields &&
+        (value->IsNumber() || value->IsUninitialized())) {
+      return false;
+    }
+  }
+  FastCloneShallowObjectStub stub(isolate(), properties_count,
+                                  LiteralPretenureFlag(node));
+  ReplaceWithICStubCall(node, &stub);
+  return true;
+}
+
+
+// Mirrors the conditions under which full-codegen uses the same stub, see
+// ArrayLiteral::depth(). Literals created by optimized code never track their
+// allocation site, see ArrayLiteral::kDisableMementos.
+bool JSGenericLowering::TryReplaceWithFastCloneShallowArray(Node* node) {
+  Int32Matcher flags(NodeProperties::GetValueInput(node, 3));
+  if (!flags.HasValue() || !(flags.Value() & ArrayLiteral::kShallowElements)) {
+    return false;
+  }
+  Handle<Object> constants = HeapConstantInput(node, 2);
+  if (constants.is_null() || !constants->IsFixedArray()) return false;
+  FixedArrayBase* constant_elements_values =
+      FixedArrayBase::cast(FixedArray::cast(*constants)->get(1));
+  if (constant_elements_values->length() >
+      JSObject::kInitialMaxFastElementArray) {
+    return false;
+  }
+  PretenureFlag pretenure_flag = LiteralPretenureFlag(node);
+  if (pretenure_flag == TENURED) {
+    // The stub shares copy-on-write elements with the boilerplate. Make sure
+    // they already live in old space, otherwise every pretenured copy would
+    // create another old-to-new-space pointer.
+    Handle<FixedArray> literals =
+        Handle<FixedArray>::cast(HeapConstantInput(node, 0));
+    Int32Matcher literal_index(NodeProperties::GetValueInput(node, 1));
+    AllocationSite* site =
+        AllocationSite::cast(literals->get(literal_index.Value()));
+    if (site->transition_info()->IsJSArray()) {
+      Handle<JSArray> boilerplate(JSArray::cast(site->transition_info()));
+      Heap* heap = isolate()->heap();
+      if (boilerplate->elements()->map() == heap->fixed_cow_array_map() &&
+          heap->InNewSpace(boilerplate->elements())) {
+        Handle<FixedArray> elements(FixedArray::cast(boilerplate->elements()));
+        boilerplate->set_elements(
+            *isolate()->factory()->CopyAndTenureFixedCOWArray(elements));
+      }
+    }
+  }
+  // The stub takes no flags, it always creates a shallow copy.
+  node->ReplaceInput(3, NodeProperties::GetContextInput(node));
+  node->ReplaceInput(4, NodeProperties::GetEffectInput(node));
+  node->ReplaceInput(5, NodeProperties::GetControlInput(node));
+  node->TrimInputCount(6);
+  FastCloneShallowArrayStub stub(isolate(), DONT_TRACK_ALLOCATION_SITE,
+                                 pretenure_flag);
+  ReplaceWithICStubCall(node, &stub);
+  return true;
+}
 }
 }
 }  // namespace v8::internal::compiler
@@ -59,6 +59,11 @@ class JSGenericLowering : public Reducer {
   void ReplaceWithBuiltinCall(Node* node, Builtins::JavaScript id, int args);
   void ReplaceWithRuntimeCall(Node* node, Runtime::FunctionId f, int args = -1);
 
+  // Helpers to replace literal creation with an inline allocating stub call.
+  bool TryReplaceWithFastCloneShallowObject(Node* node);
+  bool TryReplaceWithFastCloneShallowArray(Node* node);
+  PretenureFlag LiteralPretenureFlag(Node* node);
+
   Zone* zone() const { return graph()->zone(); }
   Isolate* isolate() const { return zone()->isolate(); }
   JSGraph* jsgraph() const { return jsgraph_; }
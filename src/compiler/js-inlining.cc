@@ -23,29 +23,62 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
-class InlinerVisitor : public NullNodeVisitor {
+// Collects the call nodes created since {first_node_id}.
+class CallSiteCollector : public NullNodeVisitor {
  public:
-  explicit InlinerVisitor(JSInliner* inliner) : inliner_(inliner) {}
+  CallSiteCollector(NodeId first_node_id, NodeVector* calls)
+      : first_node_id_(first_node_id), calls_(calls) {}
 
   GenericGraphVisit::Control Post(Node* node) {
-    switch (node->opcode()) {
-      case IrOpcode::kJSCallFunction:
-        inliner_->TryInlineCall(node);
-        break;
-      default:
-        break;
+    if (node->opcode() == IrOpcode::kJSCallFunction &&
+        node->id() >= first_node_id_) {
+      calls_->push_back(node);
     }
     return GenericGraphVisit::CONTINUE;
   }
 
  private:
-  JSInliner* inliner_;
+  NodeId first_node_id_;
+  NodeVector* calls_;
+};
+
+
+// Orders call sites by what the call IC has seen: sites that were executed
+// come first, sites without feedback next and sites that never ran last.
+class CallSiteOrder {
+ public:
+  explicit CallSiteOrder(Isolate* isolate)
+      : uninitialized_(TypeFeedbackInfo::UninitializedSentinel(isolate)) {}
+
+  bool operator()(Node* a, Node* b) const { return Rank(a) > Rank(b); }
+
+ private:
+  int Rank(Node* call) const {
+    Handle<Object> feedback = OpParameter<CallParameters>(call).feedback;
+    if (feedback.is_null()) return 1;
+    return *feedback == *uninitialized_ ? 0 : 2;
+  }
+
+  Handle<Object> uninitialized_;
 };
 
 
 void JSInliner::Inline() {
-  InlinerVisitor visitor(this);
-  jsgraph_->graph()->VisitNodeInputsFromEnd(&visitor);
+  NodeVector calls(NodeVector::allocator_type(jsgraph_->zone()));
+  NodeId first_node_id = 0;
+  do {
+    // Calls in inlined functions are only considered in the next round.
+    calls.clear();
+    CallSiteCollector collector(first_node_id, &calls);
+    jsgraph_->graph()->VisitNodeInputsFromEnd(&collector);
+    first_node_id = jsgraph_->graph()->NodeCount();
+
+    std::stable_sort(calls.begin(), calls.end(),
+                     CallSiteOrder(info_->isolate()));
+    for (NodeVectorIter i = calls.begin(); i != calls.end(); ++i) {
+      TryInlineCall(*i);
+    }
+  } while (!calls.empty());
 }
 
 
@@ -267,23 +300,136 @@ void Inlinee::InlineAtCall(JSGraph* jsgraph, Node* call) {
 }
 
 
+int JSInliner::FindInlinedFunction(Node* node) {
+  for (size_t i = 0; i < inlined_functions_.size(); ++i) {
+    if (node->id() >= inlined_functions_[i].first_node_id &&
+        node->id() < inlined_functions_[i].last_node_id) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+
+bool JSInliner::IsRecursive(int caller, Handle<SharedFunctionInfo> shared) {
+  for (; caller >= 0; caller = inlined_functions_[caller].caller) {
+    if (*inlined_functions_[caller].shared == *shared) return true;
+  }
+  return *info_->shared_info() == *shared;
+}
+
+
+// Turns {call} into the fast path of a check that its callee is {function}.
+// The other path performs the call generically, and the results of both paths
+// are merged where the call used to be.
+void JSInliner::GuardCall(Node* call, Handle<JSFunction> function) {
+  Graph* graph = jsgraph_->graph();
+  CommonOperatorBuilder* common = jsgraph_->common();
+
+  // The branch condition has to be a tagged boolean like the ones built by
+  // the AstGraphBuilder, since generic lowering compares it with true.
+  Node* control = NodeProperties::GetControlInput(call);
+  Node* target = jsgraph_->HeapConstant(function);
+  Node* check = graph->NewNode(jsgraph_->javascript()->StrictEqual(),
+                               NodeProperties::GetValueInput(call, 0), target,
+                               NodeProperties::GetContextInput(call));
+  Node* branch = graph->NewNode(common->Branch(), check, control);
+  Node* if_true = graph->NewNode(common->IfTrue(), branch);
+  Node* if_false = graph->NewNode(common->IfFalse(), branch);
+
+  // The generic call carries no feedback, so it is not guarded again.
+  CallParameters p = OpParameter<CallParameters>(call);
+  NodeVector inputs(NodeVector::allocator_type(jsgraph_->zone()));
+  for (InputIter i = call->inputs().begin(); i != call->inputs().end(); ++i) {
+    inputs.push_back(*i);
+  }
+  Node* generic =
+      graph->NewNode(jsgraph_->javascript()->Call(p.arity, p.flags),
+                     static_cast<int>(inputs.size()), &inputs.front());
+  NodeProperties::ReplaceControlInput(generic, if_false);
+
+  // Everything that followed the call now follows the merge, except for the
+  // nodes the call depends on, and the check itself.
+  Node* merge = graph->NewNode(common->Merge(2), if_true, if_false);
+  MoveAllControlNodes(control, merge);
+  MoveWithDependencies(graph, call, merge, control);
+  NodeProperties::ReplaceControlInput(branch, control);
+
+  Node* value = graph->NewNode(common->Phi(2), call, generic, merge);
+  Node* effect = graph->NewNode(common->EffectPhi(2), call, generic, merge);
+  for (UseIter i = call->uses().begin(); i != call->uses().end();) {
+    if (*i == value || *i == effect) {
+      ++i;
+    } else if (NodeProperties::IsEffectEdge(i.edge())) {
+      i.UpdateToAndIncrement(effect);
+    } else {
+      DCHECK(NodeProperties::IsValueEdge(i.edge()));
+      i.UpdateToAndIncrement(value);
+    }
+  }
+  call->ReplaceInput(0, target);
+  NodeProperties::ReplaceControlInput(call, if_true);
+}
+
+
+void JSInliner::TraceNotInlining(Handle<JSFunction> function,
+                                 const char* reason) {
+  if (FLAG_trace_turbo_inlining) {
+    SmartArrayPointer<char> name = function->shared()->DebugName()->ToCString();
+    PrintF("Not Inlining %s into %s because %s\n", name.get(),
+           info_->shared_info()->DebugName()->ToCString().get(), reason);
+  }
+}
+
+
 void JSInliner::TryInlineCall(Node* node) {
   DCHECK_EQ(IrOpcode::kJSCallFunction, node->opcode());
 
+  // Calls that can lazily deoptimize have control uses, which the inlinee
+  // cannot take over yet.
+  for (UseIter i = node->uses().begin(); i != node->uses().end(); ++i) {
+    if (NodeProperties::IsControlEdge(i.edge())) return;
+  }
+
+  Handle<JSFunction> function;
+  bool guarded = false;
   ValueMatcher<Handle<JSFunction> > match(node->InputAt(0));
-  if (!match.HasValue()) {
-    return;
+  if (match.HasValue()) {
+    function = match.Value();
+  } else {
+    // Use the target the call IC has seen, unless it is from another context.
+    Handle<Object> feedback = OpParameter<CallParameters>(node).feedback;
+    if (feedback.is_null() || !feedback->IsJSFunction()) return;
+    function = Handle<JSFunction>::cast(feedback);
+    if (function->context()->native_context() !=
+        info_->closure()->context()->native_context()) {
+      return;
+    }
+    guarded = true;
   }
 
-  Handle<JSFunction> function = match.Value();
+  Handle<SharedFunctionInfo> shared(function->shared());
+  if (shared->native()) {
+    TraceNotInlining(function, "inlinee is native");
+    return;
+  }
+  if (!shared->IsInlineable()) {
+    TraceNotInlining(function, "inlinee is not inlineable");
+    return;
+  }
+  if (shared->SourceSize() > FLAG_max_inlined_source_size) {
+    TraceNotInlining(function, "inlinee is too big");
+    return;
+  }
 
-  if (function->shared()->native()) {
-    if (FLAG_trace_turbo_inlining) {
-      SmartArrayPointer<char> name =
-          function->shared()->DebugName()->ToCString();
-      PrintF("Not Inlining %s into %s because inlinee is native\n", name.get(),
-             info_->shared_info()->DebugName()->ToCString().get());
-    }
+  int caller = FindInlinedFunction(node);
+  int level = caller < 0 ? 1 : inlined_functions_[caller].level + 1;
+  if (level > FLAG_max_inlining_levels) {
+    TraceNotInlining(function, "inlining is nested too deeply");
+    return;
+  }
+  if (IsRecursive(caller, shared)) {
+    TraceNotInlining(function, "the call is recursive");
     return;
   }
 
@@ -292,24 +438,29 @@ void JSInliner::TryInlineCall(Node* node) {
 
   if (info.scope()->arguments() != NULL) {
     // For now do not inline functions that use their arguments array.
-    SmartArrayPointer<char> name = function->shared()->DebugName()->ToCString();
-    if (FLAG_trace_turbo_inlining) {
-      PrintF(
-          "Not Inlining %s into %s because inlinee uses arguments "
-          "array\n",
-          name.get(), info_->shared_info()->DebugName()->ToCString().get());
-    }
+    TraceNotInlining(function, "inlinee uses arguments array");
+    return;
+  }
+
+  int nodes_added = info.function()->ast_node_count();
+  if (nodes_added > FLAG_max_inlined_nodes) {
+    TraceNotInlining(function, "inlinee has too many AST nodes");
+    return;
+  }
+  if (inlined_nodes_ + nodes_added > FLAG_max_inlined_nodes_cumulative) {
+    TraceNotInlining(function, "the cumulative AST node limit is reached");
     return;
   }
 
   if (FLAG_trace_turbo_inlining) {
     SmartArrayPointer<char> name = function->shared()->DebugName()->ToCString();
-    PrintF("Inlining %s into %s\n", name.get(),
-           info_->shared_info()->DebugName()->ToCString().get());
+    PrintF("Inlining %s into %s%s\n", name.get(),
+           info_->shared_info()->DebugName()->ToCString().get(),
+           guarded ? " (guarded by the call target)" : "");
   }
 
   Graph graph(info_->zone());
-  graph.SetNextNodeId(jsgraph_->graph()->NextNodeID());
+  graph.SetNextNodeId(jsgraph_->graph()->NodeCount());
 
   Typer typer(info_->zone());
   CommonOperatorBuilder common(info_->zone());
@@ -320,9 +471,17 @@ void JSInliner::TryInlineCall(Node* node) {
 
   Inlinee inlinee(&jsgraph);
   inlinee.UnifyReturn();
-  inlinee.InlineAtCall(jsgraph_, node);
 
-  jsgraph_->graph()->SetNextNodeId(inlinee.graph()->NextNodeID());
+  // The inlinee's nodes keep their ids, so the nodes created in the caller's
+  // graph from here on have to come after them.
+  InlinedFunction inlined = {shared, jsgraph_->graph()->NodeCount(),
+                             graph.NodeCount(), caller, level};
+  inlined_functions_.push_back(inlined);
+  inlined_nodes_ += nodes_added;
+  jsgraph_->graph()->SetNextNodeId(graph.NodeCount());
+
+  if (guarded) GuardCall(node, function);
+  inlinee.InlineAtCall(jsgraph_, node);
 }
 }
 }
@@ -12,20 +12,47 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
+// Inlines calls to known JavaScript functions. Call sites are considered level
+// by level, so that calls in inlined functions are only looked at once their
+// caller has been inlined, and within a level the call sites that the call IC
+// saw being executed go first. Inlining stops at the size, depth and
+// cumulative budgets that Hydrogen uses as well. Calls through an unknown
+// callee are inlined for the target recorded by the call IC, guarded by a
+// check that falls back to a generic call.
 class JSInliner {
  public:
   JSInliner(CompilationInfo* info, JSGraph* jsgraph)
-      : info_(info), jsgraph_(jsgraph) {}
+      : info_(info),
+        jsgraph_(jsgraph),
+        inlined_functions_(InlinedFunctions::allocator_type(jsgraph->zone())),
+        inlined_nodes_(0) {}
 
   void Inline();
   void TryInlineCall(Node* node);
 
  private:
-  friend class InlinerVisitor;
+  // A function that has been inlined. The nodes of its graph have ids in
+  // [first_node_id, last_node_id), which identifies the inlined function a
+  // call node belongs to.
+  struct InlinedFunction {
+    Handle<SharedFunctionInfo> shared;
+    NodeId first_node_id;
+    NodeId last_node_id;
+    int caller;  // Index of the caller, or -1 for the function being compiled.
+    int level;
+  };
+  typedef std::vector<InlinedFunction, zone_allocator<InlinedFunction> >
+      InlinedFunctions;
+
+  int FindInlinedFunction(Node* node);
+  bool IsRecursive(int caller, Handle<SharedFunctionInfo> shared);
+  void GuardCall(Node* call, Handle<JSFunction> function);
+  void TraceNotInlining(Handle<JSFunction> function, const char* reason);
+
   CompilationInfo* info_;
   JSGraph* jsgraph_;
-
-  static void UnifyReturn(Graph* graph);
+  InlinedFunctions inlined_functions_;
+  int inlined_nodes_;  // Cumulative AST node count of the inlined functions.
 };
 }
 }
@@ -45,10 +45,13 @@ struct LoadNamedParameters {
 };
 
 // Defines the arity and the call flags for a JavaScript function call. This is
-// used as a parameter by JSCall operators.
+// used as a parameter by JSCall operators. The {feedback} is whatever the call
+// IC recorded for the call site in unoptimized code (a target function or one
+// of the TypeFeedbackInfo sentinels), or a null handle if there is none.
 struct CallParameters {
   int arity;
   CallFunctionFlags flags;
+  Handle<Object> feedback;
 };
 
 // Interface for building JavaScript-level operators, e.g. directly from the
@@ -104,8 +107,9 @@ class JSOperatorBuilder {
 
   Operator* Create() { SIMPLE(JSCreate, Operator::kEliminatable, 0, 1); }
 
-  Operator* Call(int arguments, CallFunctionFlags flags) {
-    CallParameters parameters = {arguments, flags};
+  Operator* Call(int arguments, CallFunctionFlags flags,
+                 Handle<Object> feedback = Handle<Object>()) {
+    CallParameters parameters = {arguments, flags, feedback};
     OP1(JSCallFunction, CallParameters, parameters, Operator::kNoProperties,
         arguments, 1);
   }
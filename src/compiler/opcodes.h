@@ -38,6 +38,7 @@
   V(Finish)              \
   V(FrameState)          \
   V(StateValues)         \
+  V(ObjectState)         \
   V(Call)                \
   V(Parameter)           \
   V(Projection)
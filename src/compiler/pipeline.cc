@@ -7,6 +7,7 @@
 #include "src/base/platform/elapsed-timer.h"
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/code-generator.h"
+#include "src/compiler/escape-analysis.h"
 #include "src/compiler/graph-replay.h"
 #include "src/compiler/graph-visualizer.h"
 #include "src/compiler/instruction.h"
@@ -21,6 +22,7 @@
 #include "src/compiler/scheduler.h"
 #include "src/compiler/simplified-lowering.h"
 #include "src/compiler/typer.h"
+#include "src/compiler/value-numbering-reducer.h"
 #include "src/compiler/verifier.h"
 #include "src/hydrogen.h"
 #include "src/ostreams.h"
@@ -142,7 +144,45 @@ static void TraceSchedule(Schedule* schedule) {
 }
 
 
+// The state of a pipeline that is carried over from graph creation to the
+// later phases. It is allocated in the compilation zone so that it survives
+// the hand-off to the concurrent recompilation thread.
+struct PipelineData : public ZoneObject {
+  explicit PipelineData(Zone* zone)
+      : graph(zone),
+        source_positions(&graph),
+        typer(zone),
+        common(zone),
+        jsgraph(&graph, &common, &typer),
+        context_node(NULL),
+        linkage(NULL),
+        schedule(NULL),
+        sequence(NULL) {}
+
+  Graph graph;
+  SourcePositionTable source_positions;
+  // TODO(turbofan): there is no need to type anything during initial graph
+  // construction.  This is currently only needed for the node cache, which the
+  // typer could sweep over later.
+  Typer typer;
+  CommonOperatorBuilder common;
+  JSGraph jsgraph;
+  Node* context_node;
+  Linkage* linkage;
+  Schedule* schedule;
+  InstructionSequence* sequence;
+};
+
+
 Handle<Code> Pipeline::GenerateCode() {
+  if (!CreateGraph()) return Handle<Code>::null();
+  if (!OptimizeGraph()) return Handle<Code>::null();
+  return AssembleCode();
+}
+
+
+bool Pipeline::CreateGraph() {
+  DCHECK(data_ == NULL);
   if (FLAG_turbo_stats) isolate()->GetTStatistics()->Initialize(info_);
 
   if (FLAG_trace_turbo) {
@@ -154,115 +194,163 @@ Handle<Code> Pipeline::GenerateCode() {
   }
 
   // Build the graph.
-  Graph graph(zone());
-  SourcePositionTable source_positions(&graph);
-  source_positions.AddDecorator();
-  // TODO(turbofan): there is no need to type anything during initial graph
-  // construction.  This is currently only needed for the node cache, which the
-  // typer could sweep over later.
-  Typer typer(zone());
-  CommonOperatorBuilder common(zone());
-  JSGraph jsgraph(&graph, &common, &typer);
-  Node* context_node;
+  data_ = new (zone()) PipelineData(zone());
+  Graph* graph = &data_->graph;
+  JSGraph* jsgraph = &data_->jsgraph;
+  SourcePositionTable* source_positions = &data_->source_positions;
+  source_positions->AddDecorator();
   {
     PhaseStats graph_builder_stats(info(), PhaseStats::CREATE_GRAPH,
                                    "graph builder");
-    AstGraphBuilderWithPositions graph_builder(info(), &jsgraph,
-                                               &source_positions);
+    AstGraphBuilderWithPositions graph_builder(info(), jsgraph,
+                                               source_positions);
     graph_builder.CreateGraph();
-    context_node = graph_builder.GetFunctionContext();
+    data_->context_node = graph_builder.GetFunctionContext();
   }
   {
     PhaseStats phi_reducer_stats(info(), PhaseStats::CREATE_GRAPH,
                                  "phi reduction");
     PhiReducer phi_reducer;
-    GraphReducer graph_reducer(&graph);
+    GraphReducer graph_reducer(graph);
     graph_reducer.AddReducer(&phi_reducer);
     graph_reducer.ReduceGraph();
-    // TODO(mstarzinger): Running reducer once ought to be enough for everyone.
-    graph_reducer.ReduceGraph();
-    graph_reducer.ReduceGraph();
   }
 
-  VerifyAndPrintGraph(&graph, "Initial untyped");
+  VerifyAndPrintGraph(graph, "Initial untyped");
 
   if (FLAG_context_specialization) {
-    SourcePositionTable::Scope pos(&source_positions,
+    SourcePositionTable::Scope pos(source_positions,
                                    SourcePosition::Unknown());
     // Specialize the code to the context as aggressively as possible.
-    JSContextSpecializer spec(info(), &jsgraph, context_node);
+    JSContextSpecializer spec(info(), jsgraph, data_->context_node);
     spec.SpecializeToContext();
-    VerifyAndPrintGraph(&graph, "Context specialized");
+    VerifyAndPrintGraph(graph, "Context specialized");
   }
 
   if (FLAG_turbo_inlining) {
-    SourcePositionTable::Scope pos(&source_positions,
+    SourcePositionTable::Scope pos(source_positions,
                                    SourcePosition::Unknown());
-    JSInliner inliner(info(), &jsgraph);
+    JSInliner inliner(info(), jsgraph);
     inliner.Inline();
-    VerifyAndPrintGraph(&graph, "Inlined");
+    VerifyAndPrintGraph(graph, "Inlined");
   }
 
   // Print a replay of the initial graph.
   if (FLAG_print_turbo_replay) {
-    GraphReplayPrinter::PrintReplay(&graph);
+    GraphReplayPrinter::PrintReplay(graph);
   }
 
   if (FLAG_turbo_types) {
     {
       // Type the graph.
       PhaseStats typer_stats(info(), PhaseStats::CREATE_GRAPH, "typer");
-      typer.Run(&graph, info()->context());
+      data_->typer.Run(graph, info()->context());
     }
     // All new nodes must be typed.
-    typer.DecorateGraph(&graph);
+    data_->typer.DecorateGraph(graph);
     {
       // Lower JSOperators where we can determine types.
       PhaseStats lowering_stats(info(), PhaseStats::CREATE_GRAPH,
                                 "typed lowering");
-      SourcePositionTable::Scope pos(&source_positions,
+      SourcePositionTable::Scope pos(source_positions,
                                      SourcePosition::Unknown());
-      JSTypedLowering lowering(&jsgraph);
-      GraphReducer graph_reducer(&graph);
+      JSTypedLowering lowering(jsgraph);
+      GraphReducer graph_reducer(graph);
       graph_reducer.AddReducer(&lowering);
       graph_reducer.ReduceGraph();
 
-      VerifyAndPrintGraph(&graph, "Lowered typed");
+      VerifyAndPrintGraph(graph, "Lowered typed");
     }
   }
 
-  Handle<Code> code = Handle<Code>::null();
-  if (SupportedTarget()) {
-    {
-      // Lower any remaining generic JSOperators.
-      PhaseStats lowering_stats(info(), PhaseStats::CREATE_GRAPH,
-                                "generic lowering");
-      SourcePositionTable::Scope pos(&source_positions,
-                                     SourcePosition::Unknown());
-      MachineOperatorBuilder machine(zone());
-      JSGenericLowering lowering(info(), &jsgraph, &machine);
-      GraphReducer graph_reducer(&graph);
-      graph_reducer.AddReducer(&lowering);
-      graph_reducer.ReduceGraph();
+  if (FLAG_turbo_escape) {
+    // Replace object literals that do not escape by their fields.
+    PhaseStats escape_stats(info(), PhaseStats::CREATE_GRAPH,
+                            "escape analysis");
+    SourcePositionTable::Scope pos(source_positions,
+                                   SourcePosition::Unknown());
+    EscapeAnalysis escape_analysis(jsgraph);
+    escape_analysis.Run();
+    VerifyAndPrintGraph(graph, "Escape analyzed");
+  }
 
-      VerifyAndPrintGraph(&graph, "Lowered generic");
-    }
+  if (!SupportedTarget()) return false;
+
+  {
+    // Lower any remaining generic JSOperators. This creates code stubs and
+    // therefore has to happen before the graph is handed off.
+    PhaseStats lowering_stats(info(), PhaseStats::CREATE_GRAPH,
+                              "generic lowering");
+    SourcePositionTable::Scope pos(source_positions,
+                                   SourcePosition::Unknown());
+    MachineOperatorBuilder machine(zone());
+    JSGenericLowering lowering(info(), jsgraph, &machine);
+    GraphReducer graph_reducer(graph);
+    graph_reducer.AddReducer(&lowering);
+    graph_reducer.ReduceGraph();
 
-    // Compute a schedule.
-    Schedule* schedule = ComputeSchedule(&graph);
-    TraceSchedule(schedule);
+    VerifyAndPrintGraph(graph, "Lowered generic");
+  }
 
-    {
-      // Generate optimized code.
-      PhaseStats codegen_stats(info(), PhaseStats::CODEGEN, "codegen");
-      Linkage linkage(info());
-      code = GenerateCode(&linkage, &graph, schedule, &source_positions);
-      info()->SetCode(code);
-    }
+  if (FLAG_turbo_gvn) {
+    // Remove redundant computations.
+    PhaseStats gvn_stats(info(), PhaseStats::OPTIMIZATION, "value numbering");
+    ValueNumberingReducer value_numbering(zone());
+    GraphReducer graph_reducer(graph);
+    graph_reducer.AddReducer(&value_numbering);
+    graph_reducer.ReduceGraph();
+
+    VerifyAndPrintGraph(graph, "Value numbered");
+  }
+  // No nodes are added to the graph after this point.
+  source_positions->RemoveDecorator();
+
+  // Give up early on graphs we cannot allocate registers for, so that the
+  // caller can still fall back to another compiler.
+  if (graph->NodeCount() > UnallocatedOperand::kMaxVirtualRegisters) {
+    info()->set_bailout_reason(kNotEnoughVirtualRegistersForValues);
+    return false;
+  }
+
+  data_->linkage = new (zone()) Linkage(info());
+  return true;
+}
 
-    // Print optimized code.
-    v8::internal::CodeGenerator::PrintCode(code, info());
+
+bool Pipeline::OptimizeGraph() {
+  DCHECK_NOT_NULL(data_);
+  DCHECK_NOT_NULL(data_->linkage);
+
+  // Compute a schedule.
+  data_->schedule = ComputeSchedule(&data_->graph);
+  TraceSchedule(data_->schedule);
+
+  {
+    PhaseStats selection_stats(info(), PhaseStats::CODEGEN,
+                               "instruction selection");
+    data_->sequence = SelectInstructions(data_->linkage, &data_->graph,
+                                         data_->schedule,
+                                         &data_->source_positions);
   }
+  return data_->sequence != NULL;
+}
+
+
+Handle<Code> Pipeline::AssembleCode() {
+  DCHECK_NOT_NULL(data_);
+  DCHECK_NOT_NULL(data_->sequence);
+
+  Handle<Code> code;
+  {
+    // Generate optimized code.
+    PhaseStats codegen_stats(info(), PhaseStats::CODEGEN, "codegen");
+    CodeGenerator generator(data_->sequence);
+    code = generator.GenerateCode();
+    info()->SetCode(code);
+  }
+
+  // Print optimized code.
+  v8::internal::CodeGenerator::PrintCode(code, info());
 
   if (FLAG_trace_turbo) {
     OFStream os(stdout);
@@ -293,7 +381,13 @@ Handle<Code> Pipeline::GenerateCodeForMachineGraph(Linkage* linkage,
   TraceSchedule(schedule);
 
   SourcePositionTable source_positions(graph);
-  Handle<Code> code = GenerateCode(linkage, graph, schedule, &source_positions);
+  Handle<Code> code = Handle<Code>::null();
+  InstructionSequence* sequence =
+      SelectInstructions(linkage, graph, schedule, &source_positions);
+  if (sequence != NULL) {
+    CodeGenerator generator(sequence);
+    code = generator.GenerateCode();
+  }
 #if ENABLE_DISASSEMBLER
   if (!code.is_null() && FLAG_print_opt_code) {
     CodeTracer::Scope tracing_scope(isolate()->GetCodeTracer());
@@ -305,26 +399,30 @@ Handle<Code> Pipeline::GenerateCodeForMachineGraph(Linkage* linkage,
 }
 
 
-Handle<Code> Pipeline::GenerateCode(Linkage* linkage, Graph* graph,
-                                    Schedule* schedule,
-                                    SourcePositionTable* source_positions) {
+InstructionSequence* Pipeline::SelectInstructions(
+    Linkage* linkage, Graph* graph, Schedule* schedule,
+    SourcePositionTable* source_positions) {
   DCHECK_NOT_NULL(graph);
   DCHECK_NOT_NULL(linkage);
   DCHECK_NOT_NULL(schedule);
   CHECK(SupportedBackend());
 
-  InstructionSequence sequence(linkage, graph, schedule);
+  InstructionSequence* sequence =
+      new (zone()) InstructionSequence(linkage, graph, schedule);
 
   // Select and schedule instructions covering the scheduled graph.
   {
-    InstructionSelector selector(&sequence, source_positions);
+    InstructionSelector selector(sequence, source_positions);
     selector.SelectInstructions();
   }
 
   if (FLAG_trace_turbo) {
+    // Printing heap constants dereferences their handles, which is otherwise
+    // not allowed while this runs on the concurrent recompilation thread.
+    AllowHandleDereference allow_deref;
     OFStream os(stdout);
     os << "----- Instruction sequence before register allocation -----\n"
-       << sequence;
+       << *sequence;
   }
 
   // Allocate registers.
@@ -332,24 +430,24 @@ Handle<Code> Pipeline::GenerateCode(Linkage* linkage, Graph* graph,
     int node_count = graph->NodeCount();
     if (node_count > UnallocatedOperand::kMaxVirtualRegisters) {
       linkage->info()->set_bailout_reason(kNotEnoughVirtualRegistersForValues);
-      return Handle<Code>::null();
+      return NULL;
     }
-    RegisterAllocator allocator(&sequence);
+    RegisterAllocator allocator(sequence,
+                                RegisterAllocator::StrategyFor(sequence));
     if (!allocator.Allocate()) {
       linkage->info()->set_bailout_reason(kNotEnoughVirtualRegistersRegalloc);
-      return Handle<Code>::null();
+      return NULL;
     }
   }
 
   if (FLAG_trace_turbo) {
+    AllowHandleDereference allow_deref;
     OFStream os(stdout);
     os << "----- Instruction sequence after register allocation -----\n"
-       << sequence;
+       << *sequence;
   }
 
-  // Generate native sequence.
-  CodeGenerator generator(&sequence);
-  return generator.GenerateCode();
+  return sequence;
 }
 
 
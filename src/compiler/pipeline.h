@@ -18,17 +18,34 @@ namespace compiler {
 
 // Clients of this interface shouldn't depend on lots of compiler internals.
 class Graph;
+class InstructionSequence;
 class Schedule;
 class SourcePositionTable;
 class Linkage;
+struct PipelineData;
 
-class Pipeline {
+// The pipeline can either be run in one go through GenerateCode(), or in the
+// three phases of an OptimizedCompileJob: CreateGraph and AssembleCode need
+// the heap and run on the main thread, OptimizeGraph does not touch the heap
+// and can run on the concurrent recompilation thread in between.
+class Pipeline : public ZoneObject {
  public:
-  explicit Pipeline(CompilationInfo* info) : info_(info) {}
+  explicit Pipeline(CompilationInfo* info) : info_(info), data_(NULL) {}
 
   // Run the entire pipeline and generate a handle to a code object.
   Handle<Code> GenerateCode();
 
+  // Build the graph and lower it to machine operators. Returns false if the
+  // function cannot be compiled with TurboFan.
+  bool CreateGraph();
+
+  // Schedule the graph, select instructions and allocate registers. Returns
+  // false on bailout, the reason is recorded in the compilation info.
+  bool OptimizeGraph();
+
+  // Assemble the instruction sequence into a code object.
+  Handle<Code> AssembleCode();
+
   // Run the pipeline on a machine graph and generate code. If {schedule}
   // is {NULL}, then compute a new schedule for code generation.
   Handle<Code> GenerateCodeForMachineGraph(Linkage* linkage, Graph* graph,
@@ -42,6 +59,7 @@ class Pipeline {
 
  private:
   CompilationInfo* info_;
+  PipelineData* data_;
 
   CompilationInfo* info() const { return info_; }
   Isolate* isolate() { return info_->isolate(); }
@@ -49,8 +67,9 @@ class Pipeline {
 
   Schedule* ComputeSchedule(Graph* graph);
   void VerifyAndPrintGraph(Graph* graph, const char* phase);
-  Handle<Code> GenerateCode(Linkage* linkage, Graph* graph, Schedule* schedule,
-                            SourcePositionTable* source_positions);
+  InstructionSequence* SelectInstructions(
+      Linkage* linkage, Graph* graph, Schedule* schedule,
+      SourcePositionTable* source_positions);
 };
 }
 }
@@ -499,7 +499,8 @@ LifetimePosition LiveRange::FirstIntersection(LiveRange* other) {
 }
 
 
-RegisterAllocator::RegisterAllocator(InstructionSequence* code)
+RegisterAllocator::RegisterAllocator(InstructionSequence* code,
+                                     Strategy strategy)
     : zone_(code->isolate()),
       code_(code),
       live_in_sets_(code->BasicBlockCount(), zone()),
@@ -510,11 +511,22 @@ RegisterAllocator::RegisterAllocator(InstructionSequence* code)
       active_live_ranges_(8, zone()),
       inactive_live_ranges_(8, zone()),
       reusable_slots_(8, zone()),
+      strategy_(strategy),
       mode_(UNALLOCATED_REGISTERS),
       num_registers_(-1),
       allocation_ok_(true) {}
 
 
+RegisterAllocator::Strategy RegisterAllocator::StrategyFor(
+    InstructionSequence* code) {
+  if (FLAG_turbo_splitting &&
+      code->InstructionCount() >= FLAG_turbo_splitting_min_instructions) {
+    return kSplitting;
+  }
+  return kLinearScan;
+}
+
+
 void RegisterAllocator::InitializeLivenessAnalysis() {
   // Initialize the live_in sets for each block to NULL.
   int block_count = code()->BasicBlockCount();
@@ -1744,14 +1756,19 @@ void RegisterAllocator::FreeSpillSlot(LiveRange* range) {
 
 InstructionOperand* RegisterAllocator::TryReuseSpillSlot(LiveRange* range) {
   if (reusable_slots_.is_empty()) return NULL;
-  if (reusable_slots_.first()->End().Value() >
-      range->TopLevel()->Start().Value()) {
-    return NULL;
+  // Linear scan only looks at the oldest free slot, the splitting strategy
+  // takes any slot whose previous owner is dead by the time {range} starts.
+  int limit = strategy_ == kSplitting ? reusable_slots_.length() : 1;
+  for (int i = 0; i < limit; ++i) {
+    LiveRange* candidate = reusable_slots_[i];
+    if (candidate->End().Value() > range->TopLevel()->Start().Value()) {
+      continue;
+    }
+    InstructionOperand* result = candidate->TopLevel()->GetSpillOperand();
+    reusable_slots_.Remove(i);
+    return result;
   }
-  InstructionOperand* result =
-      reusable_slots_.first()->TopLevel()->GetSpillOperand();
-  reusable_slots_.Remove(0);
-  return result;
+  return NULL;
 }
 
 
@@ -1833,6 +1850,19 @@ bool RegisterAllocator::TryAllocateFreeReg(LiveRange* current) {
     }
   }
 
+  if (strategy_ == kSplitting) {
+    // Try to coalesce with the preceding part of a split range, which turns
+    // the connecting gap move into a redundant move.
+    int register_index = GetPredecessorRegister(current);
+    if (register_index >= 0 &&
+        free_until_pos[register_index].Value() >= current->End().Value()) {
+      TraceAlloc("Assigning predecessor reg %s to live range %d\n",
+                 RegisterName(register_index), current->id());
+      SetLiveRangeAssignedRegister(current, register_index);
+      return true;
+    }
+  }
+
   // Find the register which stays free for the longest time.
   int reg = 0;
   for (int i = 1; i < RegisterCount(); ++i) {
@@ -1850,8 +1880,13 @@ bool RegisterAllocator::TryAllocateFreeReg(LiveRange* current) {
 
   if (pos.Value() < current->End().Value()) {
     // Register reg is available at the range start but becomes blocked before
-    // the range end. Split current at position where it becomes blocked.
-    LiveRange* tail = SplitRangeAt(current, pos);
+    // the range end. Split current at position where it becomes blocked. The
+    // splitting strategy instead splits at the outermost loop header between
+    // the range start and that position, so that the connecting move is not
+    // executed on every loop iteration.
+    LiveRange* tail = strategy_ == kSplitting
+                          ? SplitBetween(current, current->Start(), pos)
+                          : SplitRangeAt(current, pos);
     if (!AllocationOk()) return false;
     AddToUnhandledSorted(tail);
   }
@@ -1868,6 +1903,22 @@ bool RegisterAllocator::TryAllocateFreeReg(LiveRange* current) {
 }
 
 
+int RegisterAllocator::GetPredecessorRegister(LiveRange* range) {
+  LiveRange* parent = range->parent();
+  if (parent == NULL) return -1;
+  LiveRange* predecessor = parent;
+  while (predecessor->next() != range) {
+    predecessor = predecessor->next();
+    if (predecessor == NULL) return -1;
+  }
+  if (!predecessor->HasRegisterAssigned()) return -1;
+  // Only coalesce if the ranges are adjacent, otherwise a move is needed
+  // anyway.
+  if (predecessor->End().Value() != range->Start().Value()) return -1;
+  return predecessor->assigned_register();
+}
+
+
 void RegisterAllocator::AllocateBlockedReg(LiveRange* current) {
   UsePosition* register_use = current->NextRegisterPosition(current->Start());
   if (register_use == NULL) {
@@ -319,7 +319,23 @@ class LiveRange : public ZoneObject {
 
 class RegisterAllocator BASE_EMBEDDED {
  public:
-  explicit RegisterAllocator(InstructionSequence* code);
+  enum Strategy {
+    // Plain linear scan allocation, as in Lithium.
+    kLinearScan,
+    // Linear scan that additionally splits live ranges at loop boundaries,
+    // shares spill slots more aggressively and prefers to keep split children
+    // in the register of their predecessor so that the connecting moves
+    // become redundant. Intended for large functions with high register
+    // pressure.
+    kSplitting
+  };
+
+  explicit RegisterAllocator(InstructionSequence* code,
+                             Strategy strategy = kLinearScan);
+
+  // Returns the allocation strategy to use for {code}, based on its size and
+  // the --turbo-splitting flags.
+  static Strategy StrategyFor(InstructionSequence* code);
 
   static void TraceAlloc(const char* msg, ...);
 
@@ -421,6 +437,7 @@ class RegisterAllocator BASE_EMBEDDED {
 
   // Helper methods for allocating registers.
   bool TryAllocateFreeReg(LiveRange* range);
+  int GetPredecessorRegister(LiveRange* range);
   void AllocateBlockedReg(LiveRange* range);
 
   // Live range splitting helpers.
@@ -513,6 +530,8 @@ class RegisterAllocator BASE_EMBEDDED {
   ZoneList<LiveRange*> inactive_live_ranges_;
   ZoneList<LiveRange*> reusable_slots_;
 
+  Strategy strategy_;
+
   RegisterKind mode_;
   int num_registers_;
 
@@ -125,6 +125,22 @@ class BasicBlock V8_FINAL : public GenericNode<BasicBlockData, BasicBlock> {
     if (IsLoopHeader()) return this;
     return static_cast<BasicBlock*>(loop_header_);
   }
+  // Returns the loop pre-header, i.e. the single block that enters the loop
+  // headed by this block from outside. Only valid for loop headers once the
+  // special RPO has been computed; the order of the predecessors is not
+  // significant.
+  inline BasicBlock* LoopPreHeader() {
+    DCHECK(IsLoopHeader());
+    BasicBlock* pre_header = NULL;
+    for (int i = 0; i < PredecessorCount(); ++i) {
+      BasicBlock* predecessor = PredecessorAt(i);
+      if (LoopContains(predecessor)) continue;  // A back edge.
+      DCHECK(pre_header == NULL);
+      pre_header = predecessor;
+    }
+    DCHECK(pre_header != NULL);
+    return pre_header;
+  }
 
   typedef NodeVector::iterator iterator;
   iterator begin() { return nodes_.begin(); }
@@ -162,6 +178,7 @@ class Schedule : public GenericGraph<BasicBlock> {
         all_blocks_(BasicBlockVector::allocator_type(zone)),
         nodeid_to_block_(BasicBlockVector::allocator_type(zone)),
         rpo_order_(BasicBlockVector::allocator_type(zone)),
+        loop_headers_(BasicBlockVector::allocator_type(zone)),
         immediate_dominator_(BasicBlockVector::allocator_type(zone)) {
     SetStart(NewBasicBlock());  // entry.
     SetEnd(NewBasicBlock());    // exit.
@@ -195,6 +212,11 @@ class Schedule : public GenericGraph<BasicBlock> {
   // Return a list of all the blocks in the schedule, in arbitrary order.
   BasicBlocks all_blocks() { return BasicBlocks(&all_blocks_); }
 
+  // Return the loop headers of the schedule in special RPO order, so that
+  // outer loops precede the loops nested within them. Together with
+  // {BasicBlock::loop_header()} this forms the loop tree of the schedule.
+  BasicBlocks loop_headers() { return BasicBlocks(&loop_headers_); }
+
   // Check if nodes {a} and {b} are in the same block.
   inline bool SameBasicBlock(Node* a, Node* b) const {
     BasicBlock* block = this->block(a);
@@ -316,6 +338,7 @@ class Schedule : public GenericGraph<BasicBlock> {
   BasicBlockVector all_blocks_;           // All basic blocks in the schedule.
   BasicBlockVector nodeid_to_block_;      // Map from node to containing block.
   BasicBlockVector rpo_order_;            // Reverse-post-order block list.
+  BasicBlockVector loop_headers_;         // Loop headers in RPO order.
   BasicBlockVector immediate_dominator_;  // Maps to a block's immediate
                                           // dominator, indexed by block
                                           // id.
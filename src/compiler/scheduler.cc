@@ -490,8 +490,10 @@ class ScheduleLateNodeVisitor : public NullNodeVisitor {
         "loop depth %d, min rpo = %d\n",
         node->id(), block->id(), block->loop_depth_, min_rpo);
     // Hoist nodes out of loops if possible. Nodes can be hoisted iteratively
-    // into enlcosing loop pre-headers until they would preceed their
-    // ScheduleEarly position.
+    // into enclosing loop pre-headers until they would precede their
+    // ScheduleEarly position. Note that a node whose uses are all in a loop
+    // header is still loop-variant code, so start from the containing loop of
+    // the block, not from the loop enclosing it.
     BasicBlock* hoist_block = block;
     while (hoist_block != NULL && hoist_block->rpo_number_ >= min_rpo) {
       if (hoist_block->loop_depth_ < block->loop_depth_) {
@@ -499,17 +501,16 @@ class ScheduleLateNodeVisitor : public NullNodeVisitor {
         Trace("Hoisting node %d to block %d\n", node->id(), block->id());
       }
       // Try to hoist to the pre-header of the loop header.
-      hoist_block = hoist_block->loop_header();
-      if (hoist_block != NULL) {
-        BasicBlock* pre_header = schedule_->dominator(hoist_block);
-        DCHECK(pre_header == NULL ||
-               *hoist_block->predecessors().begin() == pre_header);
-        Trace(
-            "Try hoist to pre-header block %d of loop header block %d,"
-            " depth would be %d\n",
-            pre_header->id(), hoist_block->id(), pre_header->loop_depth_);
-        hoist_block = pre_header;
-      }
+      BasicBlock* loop_header = hoist_block->ContainingLoop();
+      if (loop_header == NULL) break;
+      BasicBlock* pre_header = schedule_->dominator(loop_header);
+      if (pre_header == NULL) break;
+      DCHECK(loop_header->LoopPreHeader() == pre_header);
+      Trace(
+          "Try hoist to pre-header block %d of loop header block %d,"
+          " depth would be %d\n",
+          pre_header->id(), loop_header->id(), pre_header->loop_depth_);
+      hoist_block = pre_header;
     }
 
     ScheduleNode(block, node);
@@ -949,6 +950,16 @@ BasicBlockVector* Scheduler::ComputeSpecialRPO(Schedule* schedule) {
   for (BasicBlockVectorIter i = final_order->begin(); i != final_order->end();
        ++i) {
     BasicBlock* current = *i;
+    // Leave the loop(s) that ended before this block first, a loop header
+    // can directly follow the end of a preceding loop.
+    while (current_header != NULL &&
+           current->rpo_number_ >= current_header->loop_end_) {
+      DCHECK(current_header->IsLoopHeader());
+      DCHECK(current_loop != NULL);
+      current_loop = current_loop->prev;
+      current_header = current_loop == NULL ? NULL : current_loop->header;
+      --loop_depth;
+    }
     current->loop_header_ = current_header;
     if (current->IsLoopHeader()) {
       loop_depth++;
@@ -957,17 +968,9 @@ BasicBlockVector* Scheduler::ComputeSpecialRPO(Schedule* schedule) {
       current->loop_end_ = end == NULL ? static_cast<int>(final_order->size())
                                        : end->block->rpo_number_;
       current_header = current_loop->header;
+      schedule->loop_headers_.push_back(current);
       Trace("Block %d is a loop header, increment loop depth to %d\n",
             current->id(), loop_depth);
-    } else {
-      while (current_header != NULL &&
-             current->rpo_number_ >= current_header->loop_end_) {
-        DCHECK(current_header->IsLoopHeader());
-        DCHECK(current_loop != NULL);
-        current_loop = current_loop->prev;
-        current_header = current_loop == NULL ? NULL : current_loop->header;
-        --loop_depth;
-      }
     }
     current->loop_depth_ = loop_depth;
     Trace("Block %d's loop header is block %d, loop depth %d\n", current->id(),
@@ -49,12 +49,12 @@ static const int kNonHeapObjectHeaderSize = kHeapObjectTag;
 
 // Specialization for static parameters of type {FieldAccess}.
 template <>
-struct StaticParameterTraits<const FieldAccess> {
+struct StaticParameterTraits<FieldAccess> {
   static OStream& PrintTo(OStream& os, const FieldAccess& val) {  // NOLINT
     return os << val.offset;
   }
   static int HashCode(const FieldAccess& val) {
-    return (val.offset < 16) | (val.machine_type & 0xffff);
+    return (val.offset << 16) | (val.machine_type & 0xffff);
   }
   static bool Equals(const FieldAccess& a, const FieldAccess& b) {
     return a.base_is_tagged == b.base_is_tagged && a.offset == b.offset &&
@@ -65,12 +65,12 @@ struct StaticParameterTraits<const FieldAccess> {
 
 // Specialization for static parameters of type {ElementAccess}.
 template <>
-struct StaticParameterTraits<const ElementAccess> {
+struct StaticParameterTraits<ElementAccess> {
   static OStream& PrintTo(OStream& os, const ElementAccess& val) {  // NOLINT
     return os << val.header_size;
   }
   static int HashCode(const ElementAccess& val) {
-    return (val.header_size < 16) | (val.machine_type & 0xffff);
+    return (val.header_size << 16) | (val.machine_type & 0xffff);
   }
   static bool Equals(const ElementAccess& a, const ElementAccess& b) {
     return a.base_is_tagged == b.base_is_tagged &&
@@ -5,6 +5,7 @@
 #include "src/compiler/graph-inl.h"
 #include "src/compiler/js-operator.h"
 #include "src/compiler/node.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties-inl.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -92,6 +93,8 @@ class Typer::Visitor : public NullNodeVisitor {
     return NodeProperties::GetBounds(NodeProperties::GetValueInput(node, i));
   }
 
+  Type* InductionVariableType(Node* phi);
+
   Type* ContextType(Node* node) {
     Bounds result =
         NodeProperties::GetBounds(NodeProperties::GetContextInput(node));
@@ -258,10 +261,109 @@ Bounds Typer::Visitor::TypePhi(Node* node) {
   for (int i = 1; i < arity; ++i) {
     bounds = Bounds::Either(bounds, OperandType(node, i), zone());
   }
+  // Induction variables stay within the range of the loop test.
+  Type* range = InductionVariableType(node);
+  if (range != NULL) {
+    bounds = Bounds(Type::Intersect(bounds.lower, range, zone()),
+                    Type::Intersect(bounds.upper, range, zone()));
+  }
   return bounds;
 }
 
 
+// Recognizes loop phis of the form
+//
+//   i = Phi(initial, i + 1, loop)   continued only while i < limit
+//   i = Phi(initial, i - 1, loop)   continued only while i > limit
+//
+// where the loop test is the only way from the loop header into the body.
+// Then the increment cannot go past the limit, so if both the initial value
+// and the limit are 32-bit integers of the same signedness, so is every value
+// of the phi. Returns NULL for all other phis.
+Type* Typer::Visitor::InductionVariableType(Node* phi) {
+  Node* loop = NodeProperties::GetControlInput(phi);
+  if (loop->opcode() != IrOpcode::kLoop ||
+      OperatorProperties::GetValueInputCount(phi->op()) != 2) {
+    return NULL;
+  }
+
+  // The value along the back edge has to be the phi plus or minus one.
+  Node* increment = NodeProperties::GetValueInput(phi, 1);
+  bool increasing;
+  if (increment->opcode() == IrOpcode::kJSAdd) {
+    increasing = true;
+  } else if (increment->opcode() == IrOpcode::kJSSubtract) {
+    increasing = false;
+  } else {
+    return NULL;
+  }
+  Node* previous = NodeProperties::GetValueInput(increment, 0);
+  if (previous->opcode() == IrOpcode::kJSToNumber) {
+    previous = NodeProperties::GetValueInput(previous, 0);
+  }
+  if (previous != phi ||
+      !Float64Matcher(NodeProperties::GetValueInput(increment, 1)).Is(1)) {
+    return NULL;
+  }
+
+  // The loop header has to branch on a comparison of the phi right away.
+  Node* branch = NULL;
+  for (UseIter i = loop->uses().begin(); i != loop->uses().end(); ++i) {
+    if (!NodeProperties::IsControlEdge(i.edge()) ||
+        !IrOpcode::IsControlOpcode((*i)->opcode())) {
+      continue;
+    }
+    if (branch != NULL || (*i)->opcode() != IrOpcode::kBranch) return NULL;
+    branch = *i;
+  }
+  if (branch == NULL) return NULL;
+  Node* test = NodeProperties::GetValueInput(branch, 0);
+  if (test->opcode() == IrOpcode::kJSToBoolean) {
+    test = NodeProperties::GetValueInput(test, 0);
+  }
+  int limit_index;
+  if (test->opcode() == IrOpcode::kJSLessThan) {
+    limit_index = increasing ? 1 : 0;
+  } else if (test->opcode() == IrOpcode::kJSGreaterThan) {
+    limit_index = increasing ? 0 : 1;
+  } else {
+    return NULL;
+  }
+  if (NodeProperties::GetValueInput(test, 1 - limit_index) != phi) return NULL;
+
+  // Every way around the back edge has to pass the true branch.
+  Node* if_true = NULL;
+  for (UseIter i = branch->uses().begin(); i != branch->uses().end(); ++i) {
+    if ((*i)->opcode() == IrOpcode::kIfTrue) if_true = *i;
+  }
+  if (if_true == NULL) return NULL;
+  NodeSet visited(NodeSet::key_compare(),
+                  NodeSet::allocator_type(typer_->zone()));
+  NodeVector stack(NodeVector::allocator_type(typer_->zone()));
+  stack.push_back(NodeProperties::GetControlInput(loop, 1));
+  while (!stack.empty()) {
+    Node* node = stack.back();
+    stack.pop_back();
+    if (node == if_true || !visited.insert(node).second) continue;
+    if (node == loop || node->opcode() == IrOpcode::kStart) return NULL;
+    int count = OperatorProperties::GetControlInputCount(node->op());
+    for (int i = 0; i < count; ++i) {
+      stack.push_back(NodeProperties::GetControlInput(node, i));
+    }
+  }
+
+  Type* initial = OperandType(phi, 0).upper;
+  Type* limit = OperandType(test, limit_index).upper;
+  if (initial->Is(Type::Unsigned32()) && limit->Is(Type::Unsigned32())) {
+    return Type::Unsigned32(zone());
+  }
+  if (initial->Is(Type::Signed32()) && limit->Is(Type::Signed32())) {
+    return Type::Signed32(zone());
+  }
+  return NULL;
+}
+
+
 Bounds Typer::Visitor::TypeEffectPhi(Node* node) {
   return Bounds(Type::None(zone()));
 }
@@ -290,6 +392,11 @@ Bounds Typer::Visitor::TypeStateValues(Node* node) {
 }
 
 
+Bounds Typer::Visitor::TypeObjectState(Node* node) {
+  return Bounds(Type::None(zone()));
+}
+
+
 Bounds Typer::Visitor::TypeCall(Node* node) {
   return Bounds::Unbounded(zone());
 }
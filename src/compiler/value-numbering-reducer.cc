@@ -0,0 +1,89 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/value-numbering-reducer.h"
+
+#include "src/compiler/generic-node-inl.h"
+#include "src/compiler/node.h"
+#include "src/compiler/operator-properties-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+struct ValueNumberingReducer::Entry V8_FINAL : public ZoneObject {
+  Entry(Node* node, Entry* next) : node(node), next(next) {}
+
+  Node* node;
+  Entry* next;
+};
+
+
+static bool IsValueNumberable(Node* node) {
+  // Heap constant operators cannot be compared reliably, since uninitialized
+  // uniques all look alike. JSGraph::HeapConstant creates a new node on every
+  // call, so equal heap constants are not merged.
+  if (node->opcode() == IrOpcode::kHeapConstant) return false;
+  Operator* op = node->op();
+  if (!op->HasProperty(Operator::kNoWrite)) return false;
+  if (OperatorProperties::HasControlOutput(op)) return false;
+  if (!OperatorProperties::HasValueOutput(op)) return false;
+  // JavaScript operators may throw unless they say otherwise.
+  return !IrOpcode::IsJsOpcode(node->opcode()) ||
+         op->HasProperty(Operator::kNoThrow);
+}
+
+
+// Returns false for nodes that have been unlinked from the graph.
+static bool HashCode(Node* node, size_t* hash) {
+  size_t h = static_cast<size_t>(node->op()->HashCode());
+  for (InputIter i = node->inputs().begin(); i != node->inputs().end(); ++i) {
+    if (*i == NULL) return false;
+    h = h * 31 + (*i)->id();
+  }
+  *hash = h;
+  return true;
+}
+
+
+static bool Equals(Node* a, Node* b) {
+  if (a->opcode() != b->opcode()) return false;
+  if (a->InputCount() != b->InputCount()) return false;
+  if (!a->op()->Equals(b->op())) return false;
+  InputIter i = a->inputs().begin();
+  InputIter j = b->inputs().begin();
+  for (; i != a->inputs().end(); ++i, ++j) {
+    if (*i == NULL || *i != *j) return false;
+  }
+  return true;
+}
+
+
+ValueNumberingReducer::ValueNumberingReducer(Zone* zone) : zone_(zone) {
+  for (size_t i = 0; i < kNumBuckets; ++i) buckets_[i] = NULL;
+}
+
+
+Reduction ValueNumberingReducer::Reduce(Node* node) {
+  if (!IsValueNumberable(node)) return NoChange();
+  size_t hash;
+  if (!HashCode(node, &hash)) return NoChange();
+
+  Entry** head = &buckets_[hash % kNumBuckets];
+  bool present = false;
+  for (Entry* entry = *head; entry != NULL; entry = entry->next) {
+    if (entry->node == node) {
+      present = true;
+      continue;
+    }
+    // Entries are not removed when their node is changed in place, so nodes
+    // are compared in their current shape.
+    if (Equals(node, entry->node)) return Replace(entry->node);
+  }
+  if (!present) *head = new (zone()) Entry(node, *head);
+  return NoChange();
+}
+}
+}
+}  // namespace v8::internal::compiler
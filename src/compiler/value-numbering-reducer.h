@@ -0,0 +1,39 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_VALUE_NUMBERING_REDUCER_H_
+#define V8_COMPILER_VALUE_NUMBERING_REDUCER_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Performs global value numbering: a node is replaced by an earlier node with
+// an equal operator and identical inputs. Since effect and control inputs are
+// part of the comparison, nodes that read effects are only merged if they
+// observe the same effect, and nodes that write effects, produce control or
+// may throw are never merged.
+class ValueNumberingReducer V8_FINAL : public Reducer {
+ public:
+  explicit ValueNumberingReducer(Zone* zone);
+
+  virtual Reduction Reduce(Node* node) V8_OVERRIDE;
+
+ private:
+  struct Entry;
+
+  static const size_t kNumBuckets = 1024;
+
+  Zone* zone() const { return zone_; }
+
+  Entry* buckets_[kNumBuckets];
+  Zone* zone_;
+};
+}
+}
+}  // namespace v8::internal::compiler
+
+#endif  // V8_COMPILER_VALUE_NUMBERING_REDUCER_H_
@@ -151,6 +151,18 @@ class X64OperandConverter : public InstructionOperandConverter {
       case kMode_MRI:
         *first_input += 2;
         return Operand(InputRegister(offset + 0), InputInt32(offset + 1));
+      case kMode_MR2I:
+        *first_input += 3;
+        return Operand(InputRegister(offset + 0), InputRegister(offset + 1),
+                       times_2, InputInt32(offset + 2));
+      case kMode_MR4I:
+        *first_input += 3;
+        return Operand(InputRegister(offset + 0), InputRegister(offset + 1),
+                       times_4, InputInt32(offset + 2));
+      case kMode_MR8I:
+        *first_input += 3;
+        return Operand(InputRegister(offset + 0), InputRegister(offset + 1),
+                       times_8, InputInt32(offset + 2));
       default:
         UNREACHABLE();
         return Operand(no_reg, 0);
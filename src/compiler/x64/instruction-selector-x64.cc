@@ -42,19 +42,116 @@ class X64OperandGenerator V8_FINAL : public OperandGenerator {
         return true;
       case IrOpcode::kNumberConstant:
         return true;
-      case IrOpcode::kHeapConstant: {
+      case IrOpcode::kHeapConstant:
         // Constants in new space cannot be used as immediates in V8 because
         // the GC does not scan code objects when collecting the new generation.
-        Handle<HeapObject> value = ValueOf<Handle<HeapObject> >(node->op());
-        return !isolate()->heap()->InNewSpace(*value);
+        // The operator records this, since the handle must not be
+        // dereferenced on the concurrent recompilation thread.
+        return !static_cast<HeapConstantOperator*>(node->op())->InNewSpace();
+      default:
+        return false;
+    }
+  }
+};
+
+// Matches an index of the form (x * #scale) or (x * #scale) + #K, where the
+// multiplication may already have been strength-reduced to a left shift, so
+// that element accesses into Float64 and other arrays can fold the scaling
+// and the header displacement into a single [%base + %x*scale + K] operand.
+// The operand computes the address in 64 bits, so the index is only folded
+// if x is known to be zero-extended and x * scale + K cannot leave the
+// non-negative int32 range, where the 32-bit and 64-bit results agree.
+class ScaledIndexMatcher V8_FINAL {
+ public:
+  explicit ScaledIndexMatcher(Node* node)
+      : mode_(kMode_None), index_(NULL), displacement_(NULL) {
+    int32_t displacement = 0;
+    if (node->opcode() == IrOpcode::kInt32Add) {
+      Int32BinopMatcher m(node);
+      if (!m.right().IsInRange(0, kMaxInt)) return;
+      displacement = m.right().Value();
+      displacement_ = m.right().node();
+      node = m.left().node();
+    }
+    int32_t scale;
+    Node* index;
+    if (node->opcode() == IrOpcode::kInt32Mul) {
+      Int32BinopMatcher m(node);
+      if (!m.right().HasValue()) return;
+      scale = m.right().Value();
+      index = m.left().node();
+    } else if (node->opcode() == IrOpcode::kWord32Shl) {
+      Int32BinopMatcher m(node);
+      if (!m.right().IsInRange(1, 3)) return;
+      scale = 1 << m.right().Value();
+      index = m.left().node();
+    } else {
+      return;
+    }
+    uint32_t max_index;
+    if (!GetUpperBound(index, &max_index)) return;
+    uint64_t max_offset = static_cast<uint64_t>(max_index) * scale +
+                          static_cast<uint64_t>(displacement);
+    if (max_offset > static_cast<uint64_t>(kMaxInt)) return;
+    switch (scale) {
+      case 2:
+        mode_ = kMode_MR2I;
+        break;
+      case 4:
+        mode_ = kMode_MR4I;
+        break;
+      case 8:
+        mode_ = kMode_MR8I;
+        break;
+      default:
+        return;
+    }
+    index_ = index;
+  }
+
+  bool Matches() const { return mode_ != kMode_None; }
+  AddressingMode mode() const { return mode_; }
+  Node* index() const { return index_; }
+  // The constant displacement, or NULL if there is none.
+  Node* displacement() const { return displacement_; }
+
+ private:
+  // Computes an upper bound for the unsigned value of {node}, if it is
+  // produced by a 32-bit operation that clears the upper half of its 64-bit
+  // register.
+  static bool GetUpperBound(Node* node, uint32_t* bound) {
+    switch (node->opcode()) {
+      case IrOpcode::kWord32And: {
+        Uint32BinopMatcher m(node);
+        if (!m.right().HasValue()) return false;
+        *bound = m.right().Value();
+        return true;
+      }
+      case IrOpcode::kWord32Shr: {
+        Uint32BinopMatcher m(node);
+        if (!m.right().IsInRange(1, 31)) return false;
+        *bound = 0xFFFFFFFFu >> m.right().Value();
+        return true;
       }
       default:
         return false;
     }
   }
+
+  AddressingMode mode_;
+  Node* index_;
+  Node* displacement_;
 };
 
 
+// Returns the immediate operand for the displacement of a scaled index.
+static InstructionOperand* UseDisplacement(X64OperandGenerator* g,
+                                           const ScaledIndexMatcher& m) {
+  return m.displacement() == NULL ? g->TempImmediate(0)
+                                  : g->UseImmediate(m.displacement());
+}
+
+
 void InstructionSelector::VisitLoad(Node* node) {
   MachineType rep = RepresentationOf(OpParameter<MachineType>(node));
   X64OperandGenerator g(this);
@@ -95,11 +192,17 @@ void InstructionSelector::VisitLoad(Node* node) {
   } else if (g.CanBeImmediate(index)) {  // load [%base + #index]
     Emit(opcode | AddressingModeField::encode(kMode_MRI), output,
          g.UseRegister(base), g.UseImmediate(index));
-  } else {  // load [%base + %index + K]
-    Emit(opcode | AddressingModeField::encode(kMode_MR1I), output,
-         g.UseRegister(base), g.UseRegister(index));
+  } else {
+    ScaledIndexMatcher m(index);
+    if (m.Matches()) {  // load [%base + %index*scale + #K]
+      Emit(opcode | AddressingModeField::encode(m.mode()), output,
+           g.UseRegister(base), g.UseRegister(m.index()),
+           UseDisplacement(&g, m));
+    } else {  // load [%base + %index]
+      Emit(opcode | AddressingModeField::encode(kMode_MR1I), output,
+           g.UseRegister(base), g.UseRegister(index));
+    }
   }
-  // TODO(turbofan): addressing modes [r+r*{2,4,8}+K]
 }
 
 
@@ -167,11 +270,17 @@ void InstructionSelector::VisitStore(Node* node) {
   } else if (g.CanBeImmediate(index)) {  // store [%base + #index], %|#value
     Emit(opcode | AddressingModeField::encode(kMode_MRI), NULL,
          g.UseRegister(base), g.UseImmediate(index), val);
-  } else {  // store [%base + %index], %|#value
-    Emit(opcode | AddressingModeField::encode(kMode_MR1I), NULL,
-         g.UseRegister(base), g.UseRegister(index), val);
+  } else {
+    ScaledIndexMatcher m(index);
+    if (m.Matches()) {  // store [%base + %index*scale + #K], %|#value
+      Emit(opcode | AddressingModeField::encode(m.mode()), NULL,
+           g.UseRegister(base), g.UseRegister(m.index()),
+           UseDisplacement(&g, m), val);
+    } else {  // store [%base + %index], %|#value
+      Emit(opcode | AddressingModeField::encode(kMode_MR1I), NULL,
+           g.UseRegister(base), g.UseRegister(index), val);
+    }
   }
-  // TODO(turbofan): addressing modes [r+r*{2,4,8}+K]
 }
 
 
@@ -1462,6 +1462,11 @@ int Shell::RunMain(Isolate* isolate, int argc, char* argv[]) {
 static void DumpHeapConstants(i::Isolate* isolate) {
   i::Heap* heap = isolate->heap();
 
+  // The spaces are iterated below, which requires them to be swept.
+  if (heap->mark_compact_collector()->sweeping_in_progress()) {
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+  }
+
   // Dump the INSTANCE_TYPES table to the console.
   printf("# List of known V8 instance types.\n");
 #define DUMP_TYPE(T) printf("  %d: \"%s\",\n", i::T, #T);
@@ -1544,19 +1549,23 @@ class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
 class StartupDataHandler {
  public:
   StartupDataHandler(const char* natives_blob,
-                     const char* snapshot_blob) {
-    Load(natives_blob, &natives_, v8::V8::SetNativesDataBlob);
-    Load(snapshot_blob, &snapshot_, v8::V8::SetSnapshotDataBlob);
+                     const char* snapshot_blob)
+      : natives_file_(NULL), snapshot_file_(NULL) {
+    Load(natives_blob, &natives_, &natives_file_,
+         v8::V8::SetNativesDataBlob);
+    Load(snapshot_blob, &snapshot_, &snapshot_file_,
+         v8::V8::SetSnapshotDataBlob);
   }
 
   ~StartupDataHandler() {
-    delete[] natives_.data;
-    delete[] snapshot_.data;
+    Unload(&natives_, natives_file_);
+    Unload(&snapshot_, snapshot_file_);
   }
 
  private:
   void Load(const char* blob_file,
             v8::StartupData* startup_data,
+            base::OS::MemoryMappedFile** mapped_file,
             void (*setter_fn)(v8::StartupData*)) {
     startup_data->data = NULL;
     startup_data->compressed_size = 0;
@@ -1565,6 +1574,19 @@ class StartupDataHandler {
     if (!blob_file)
       return;
 
+    // V8 reads the blobs in place and never writes to them. Map them
+    // read-only so that their pages are shared between processes and only
+    // loaded when used.
+    *mapped_file = base::OS::MemoryMappedFile::open(
+        blob_file, base::OS::MemoryMappedFile::READ_ONLY);
+    if (*mapped_file) {
+      startup_data->data = static_cast<char*>((*mapped_file)->memory());
+      startup_data->raw_size = (*mapped_file)->size();
+      startup_data->compressed_size = startup_data->raw_size;
+      (*setter_fn)(startup_data);
+      return;
+    }
+
     FILE* file = fopen(blob_file, "rb");
     if (!file)
       return;
@@ -1583,8 +1605,19 @@ class StartupDataHandler {
       (*setter_fn)(startup_data);
   }
 
+  void Unload(v8::StartupData* startup_data,
+              base::OS::MemoryMappedFile* mapped_file) {
+    if (mapped_file) {
+      delete mapped_file;
+    } else {
+      delete[] startup_data->data;
+    }
+  }
+
   v8::StartupData natives_;
   v8::StartupData snapshot_;
+  base::OS::MemoryMappedFile* natives_file_;
+  base::OS::MemoryMappedFile* snapshot_file_;
 
   // Disallow copy & assign.
   StartupDataHandler(const StartupDataHandler& other);
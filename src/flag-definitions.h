@@ -339,6 +339,14 @@ DEFINE_BOOL(context_specialization, true,
             "enable context specialization in TurboFan")
 DEFINE_BOOL(turbo_deoptimization, false, "enable deoptimization in TurboFan")
 DEFINE_BOOL(turbo_inlining, false, "enable inlining in TurboFan")
+DEFINE_BOOL(turbo_escape, false,
+            "replace non-escaping object literals by their fields in TurboFan")
+DEFINE_BOOL(turbo_gvn, true, "use global value numbering in TurboFan")
+DEFINE_BOOL(turbo_splitting, false,
+            "split live ranges at loop boundaries in TurboFan register "
+            "allocation of large functions")
+DEFINE_INT(turbo_splitting_min_instructions, 1000,
+           "minimum number of instructions for --turbo-splitting")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
 
 DEFINE_INT(typed_array_max_size_in_heap, 64,
@@ -487,6 +495,9 @@ DEFINE_INT(max_semi_space_size, 0,
 DEFINE_INT(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_INT(max_executable_size, 0, "max size of executable memory (in Mbytes)")
 DEFINE_BOOL(gc_global, false, "always perform global GCs")
+DEFINE_BOOL(parallel_store_buffer_scanning, false,
+            "search pages that overflowed the store buffer for pointers to "
+            "new space on background threads during scavenges")
 DEFINE_INT(gc_interval, -1, "garbage collect after <n> allocations")
 DEFINE_BOOL(trace_gc, false,
             "print one trace line following each garbage collection")
@@ -495,6 +506,10 @@ DEFINE_BOOL(trace_gc_nvp, false,
             "after each garbage collection")
 DEFINE_BOOL(trace_gc_ignore_scavenger, false,
             "do not print trace line after scavenger collection")
+DEFINE_BOOL(trace_idle_notification, false,
+            "print one trace line following each idle notification")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "back large heap reservations with transparent huge pages")
 DEFINE_BOOL(print_cumulative_gc_stat, false,
             "print cumulative GC statistics in name=value format on exit")
 DEFINE_BOOL(print_max_heap_committed, false,
@@ -529,9 +544,12 @@ DEFINE_BOOL(track_gc_object_stats, false,
 DEFINE_BOOL(always_precise_sweeping, true, "always sweep precisely")
 DEFINE_BOOL(parallel_sweeping, false, "enable parallel sweeping")
 DEFINE_BOOL(concurrent_sweeping, true, "enable concurrent sweeping")
-DEFINE_INT(sweeper_threads, 0,
-           "number of parallel and concurrent sweeping threads")
-DEFINE_BOOL(job_based_sweeping, false, "enable job based sweeping")
+DEFINE_BOOL(parallel_marking, false,
+            "mark objects on background threads during full GCs, including "
+            "the pause that finishes incremental marking")
+DEFINE_BOOL(parallel_pointer_update, false,
+            "update pointers to evacuated objects on background threads "
+            "during compaction")
 #ifdef VERIFY_HEAP
 DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
@@ -662,6 +680,9 @@ DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_osr)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(predictable, parallel_sweeping)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_store_buffer_scanning)
+DEFINE_NEG_IMPLICATION(predictable, parallel_pointer_update)
 
 
 //
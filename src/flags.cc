@@ -548,4 +548,18 @@ void FlagList::EnforceFlagImplications() {
 #undef FLAG_MODE_DEFINE_IMPLICATIONS
 }
 
+
+// static
+uint32_t FlagList::Hash() {
+  OStringStream modified_args;
+  for (size_t i = 0; i < num_flags; ++i) {
+    Flag* f = &flags[i];
+    if (f->type() == Flag::TYPE_ARGS || f->IsDefault()) continue;
+    modified_args << "--" << f->name() << "=" << *f << " ";
+  }
+  const char* args = modified_args.c_str();
+  return StringHasher::HashSequentialString(
+      args, static_cast<int>(modified_args.size()), kZeroHashSeed);
+}
+
 } }  // namespace v8::internal
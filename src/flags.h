@@ -57,6 +57,10 @@ class FlagList {
 
   // Set flags as consequence of being implied by another flag.
   static void EnforceFlagImplications();
+
+  // Hash of the values of all flags that differ from their default, used to
+  // check that cached data was produced with the same flags.
+  static uint32_t Hash();
 };
 
 } }  // namespace v8::internal
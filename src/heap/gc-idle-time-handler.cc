@@ -4,11 +4,42 @@
 
 #include "src/heap/gc-idle-time-handler.h"
 
+#include "src/flags.h"
+#include "src/utils.h"
+
 namespace v8 {
 namespace internal {
 
 
 const double GCIdleTimeHandler::kConservativeTimeRatio = 0.9;
+const double GCIdleTimeHandler::kNewSpaceAlmostFullRatio = 0.8;
+
+
+void GCIdleTimeAction::Print() {
+  switch (type) {
+    case DONE:
+      PrintF("done");
+      break;
+    case DO_NOTHING:
+      PrintF("no action");
+      break;
+    case DO_INCREMENTAL_MARKING:
+      PrintF("incremental marking with step %" V8_PTR_PREFIX "d", parameter);
+      break;
+    case DO_SCAVENGE:
+      PrintF("scavenge");
+      break;
+    case DO_FULL_GC:
+      PrintF("full GC");
+      break;
+    case DO_FINALIZE_SWEEPING:
+      PrintF("finalize sweeping");
+      break;
+    case DO_RELEASE_MEMORY:
+      PrintF("release memory");
+      break;
+  }
+}
 
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
@@ -32,5 +63,142 @@ size_t GCIdleTimeHandler::EstimateMarkingStepSize(
   return static_cast<size_t>(marking_step_size *
                              GCIdleTimeHandler::kConservativeTimeRatio);
 }
+
+
+size_t GCIdleTimeHandler::EstimateMarkCompactTime(
+    size_t size_of_objects, size_t mark_compact_speed_in_bytes_per_ms) {
+  if (mark_compact_speed_in_bytes_per_ms == 0) {
+    mark_compact_speed_in_bytes_per_ms = kInitialConservativeMarkCompactSpeed;
+  }
+  size_t result = size_of_objects / mark_compact_speed_in_bytes_per_ms;
+  return Min(result, kMaxMarkCompactTimeInMs);
+}
+
+
+size_t GCIdleTimeHandler::EstimateScavengeTime(
+    size_t new_space_size, size_t scavenge_speed_in_bytes_per_ms) {
+  if (scavenge_speed_in_bytes_per_ms == 0) {
+    scavenge_speed_in_bytes_per_ms = kInitialConservativeScavengeSpeed;
+  }
+  return new_space_size / scavenge_speed_in_bytes_per_ms;
+}
+
+
+bool GCIdleTimeHandler::ScavengeMayHappenSoon(size_t used_new_space_size,
+                                              size_t new_space_capacity) {
+  return used_new_space_size >=
+         static_cast<size_t>(new_space_capacity * kNewSpaceAlmostFullRatio);
+}
+
+
+// The following logic is implemented by the idle time handler:
+// 1) If incremental marking is stopped and a full mark-compact fits into the
+//    idle time, do a full GC after context disposal, at the end of an idle
+//    round, or when incremental marking cannot be started.
+// 2) If the new space is almost full and a scavenge fits into the idle time,
+//    perform a scavenge instead of letting the mutator trigger it.
+// 3) If incremental marking is stopped and the sweeper is still running,
+//    wait for it when there is enough idle time.
+// 4) Otherwise, start incremental marking if needed and perform a marking
+//    step sized by the measured marking speed.
+// By doing small chunks of GC work in each IdleNotification, we perform a
+// round of incremental GCs and after that wait until the mutator creates
+// enough garbage to justify a new round.
+GCIdleTimeAction GCIdleTimeHandler::Compute(size_t idle_time_in_ms,
+                                            HeapState heap_state) {
+  if (memory_reducer_active_) {
+    return ComputeMemoryReducerAction(idle_time_in_ms, heap_state);
+  }
+
+  if (heap_state.contexts_disposed > 0) {
+    // After context disposal there is likely a lot of garbage remaining,
+    // start a new idle round in order to trigger more incremental GCs.
+    StartIdleRound();
+  } else if (IsIdleRoundFinished()) {
+    if (EnoughGarbageSinceLastIdleRound()) {
+      StartIdleRound();
+    } else {
+      return GCIdleTimeAction::Done();
+    }
+  }
+
+  if (idle_time_in_ms == 0) return GCIdleTimeAction::Nothing();
+
+  if (heap_state.incremental_marking_stopped) {
+    size_t estimated_time_in_ms =
+        EstimateMarkCompactTime(heap_state.size_of_objects,
+                                heap_state.mark_compact_speed_in_bytes_per_ms);
+    if (idle_time_in_ms >= estimated_time_in_ms) {
+      // If there are no more than two GCs left in this idle round and we are
+      // allowed to do a full GC, then make those GCs full in order to compact
+      // the code space. Tests that expose gc() dispose contexts on purpose
+      // and do not expect extra full GCs for that.
+      // TODO(ulan): Once we enable code compaction for incremental marking,
+      // we can get rid of this special case and always start incremental
+      // marking.
+      int remaining_mark_compacts =
+          kMaxMarkCompactsInIdleRound - mark_compacts_since_idle_round_started_;
+      if ((heap_state.contexts_disposed > 0 && !FLAG_expose_gc) ||
+          remaining_mark_compacts <= 2 ||
+          !heap_state.can_start_incremental_marking) {
+        return GCIdleTimeAction::FullGC();
+      }
+    }
+  }
+
+  if (ScavengeMayHappenSoon(heap_state.used_new_space_size,
+                            heap_state.new_space_capacity) &&
+      idle_time_in_ms >=
+          EstimateScavengeTime(heap_state.used_new_space_size,
+                               heap_state.scavenge_speed_in_bytes_per_ms)) {
+    return GCIdleTimeAction::Scavenge();
+  }
+
+  if (heap_state.incremental_marking_stopped) {
+    if (heap_state.sweeping_in_progress &&
+        idle_time_in_ms >= kMinTimeForFinalizeSweeping) {
+      return GCIdleTimeAction::FinalizeSweeping();
+    }
+    if (!heap_state.can_start_incremental_marking) {
+      return GCIdleTimeAction::Nothing();
+    }
+  }
+
+  size_t step_size = EstimateMarkingStepSize(
+      idle_time_in_ms, heap_state.incremental_marking_speed_in_bytes_per_ms);
+  return GCIdleTimeAction::IncrementalMarking(step_size);
+}
+
+
+// The memory reducer compacts the heap with full GCs if they fit into the idle
+// time, otherwise with incremental marking. Once enough mark-compacts were
+// done, the unused memory is released and the idle round is finished, so that
+// an idle isolate does no further work until the mutator creates garbage.
+GCIdleTimeAction GCIdleTimeHandler::ComputeMemoryReducerAction(
+    size_t idle_time_in_ms, HeapState heap_state) {
+  if (memory_reducer_mark_compacts_left_ == 0) {
+    memory_reducer_active_ = false;
+    FinishIdleRound();
+    return GCIdleTimeAction::ReleaseMemory();
+  }
+
+  if (idle_time_in_ms == 0) return GCIdleTimeAction::Nothing();
+
+  if (heap_state.incremental_marking_stopped) {
+    size_t estimated_time_in_ms =
+        EstimateMarkCompactTime(heap_state.size_of_objects,
+                                heap_state.mark_compact_speed_in_bytes_per_ms);
+    if (idle_time_in_ms >= estimated_time_in_ms) {
+      return GCIdleTimeAction::FullGC();
+    }
+    if (!heap_state.can_start_incremental_marking) {
+      return GCIdleTimeAction::Nothing();
+    }
+  }
+
+  size_t step_size = EstimateMarkingStepSize(
+      idle_time_in_ms, heap_state.incremental_marking_speed_in_bytes_per_ms);
+  return GCIdleTimeAction::IncrementalMarking(step_size);
+}
 }
 }
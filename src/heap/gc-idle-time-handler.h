@@ -10,13 +10,79 @@
 namespace v8 {
 namespace internal {
 
+enum GCIdleTimeActionType {
+  DONE,
+  DO_NOTHING,
+  DO_INCREMENTAL_MARKING,
+  DO_SCAVENGE,
+  DO_FULL_GC,
+  DO_FINALIZE_SWEEPING,
+  DO_RELEASE_MEMORY
+};
+
+
+class GCIdleTimeAction {
+ public:
+  static GCIdleTimeAction Done() {
+    GCIdleTimeAction result;
+    result.type = DONE;
+    result.parameter = 0;
+    return result;
+  }
+
+  static GCIdleTimeAction Nothing() {
+    GCIdleTimeAction result;
+    result.type = DO_NOTHING;
+    result.parameter = 0;
+    return result;
+  }
+
+  static GCIdleTimeAction IncrementalMarking(intptr_t step_size) {
+    GCIdleTimeAction result;
+    result.type = DO_INCREMENTAL_MARKING;
+    result.parameter = step_size;
+    return result;
+  }
+
+  static GCIdleTimeAction Scavenge() {
+    GCIdleTimeAction result;
+    result.type = DO_SCAVENGE;
+    result.parameter = 0;
+    return result;
+  }
+
+  static GCIdleTimeAction FullGC() {
+    GCIdleTimeAction result;
+    result.type = DO_FULL_GC;
+    result.parameter = 0;
+    return result;
+  }
+
+  static GCIdleTimeAction FinalizeSweeping() {
+    GCIdleTimeAction result;
+    result.type = DO_FINALIZE_SWEEPING;
+    result.parameter = 0;
+    return result;
+  }
+
+  static GCIdleTimeAction ReleaseMemory() {
+    GCIdleTimeAction result;
+    result.type = DO_RELEASE_MEMORY;
+    result.parameter = 0;
+    return result;
+  }
+
+  void Print();
+
+  GCIdleTimeActionType type;
+  intptr_t parameter;
+};
+
+
 // The idle time handler makes decisions about which garbage collection
 // operations are executing during IdleNotification.
 class GCIdleTimeHandler {
  public:
-  static size_t EstimateMarkingStepSize(size_t idle_time_in_ms,
-                                        size_t marking_speed_in_bytes_per_ms);
-
   // If we haven't recorded any incremental marking events yet, we carefully
   // mark with a conservative lower bound for the marking speed.
   static const size_t kInitialConservativeMarkingSpeed = 100 * KB;
@@ -28,7 +94,124 @@ class GCIdleTimeHandler {
   // idle_time_in_ms. Hence, we conservatively prune our workload estimate.
   static const double kConservativeTimeRatio;
 
+  // If we haven't recorded any mark-compact events yet, we use
+  // conservative lower bound for the mark-compact speed.
+  static const size_t kInitialConservativeMarkCompactSpeed = 2 * MB;
+
+  // Maximum mark-compact time returned by EstimateMarkCompactTime.
+  static const size_t kMaxMarkCompactTimeInMs = 1000;
+
+  // If we haven't recorded any scavenger events yet, we use a conservative
+  // lower bound for the scavenger speed.
+  static const size_t kInitialConservativeScavengeSpeed = 100 * KB;
+
+  // A scavenge is likely to be triggered by the mutator soon once the used
+  // part of the new space exceeds this ratio of its capacity.
+  static const double kNewSpaceAlmostFullRatio;
+
+  // Minimum idle time that allows to wait for the sweeper to finish.
+  static const size_t kMinTimeForFinalizeSweeping = 100;
+
+  // Number of idle mark-compact events, after which idle handler will finish
+  // idle round.
+  static const int kMaxMarkCompactsInIdleRound = 7;
+
+  // Number of scavenges that will trigger start of new idle round.
+  static const int kIdleScavengeThreshold = 5;
+
+  // Number of compacting mark-compacts the memory reducer performs before
+  // it releases the unused memory.
+  static const int kMemoryReducerMarkCompacts = 3;
+
+  // Snapshot of the heap taken by Heap::IdleNotification. Speeds are the
+  // averages measured by the GCTracer, zero if nothing was measured yet.
+  struct HeapState {
+    int contexts_disposed;
+    size_t size_of_objects;
+    bool incremental_marking_stopped;
+    bool can_start_incremental_marking;
+    bool sweeping_in_progress;
+    size_t mark_compact_speed_in_bytes_per_ms;
+    size_t incremental_marking_speed_in_bytes_per_ms;
+    size_t scavenge_speed_in_bytes_per_ms;
+    size_t used_new_space_size;
+    size_t new_space_capacity;
+  };
+
+  GCIdleTimeHandler()
+      : mark_compacts_since_idle_round_started_(0),
+        scavenges_since_last_idle_round_(kIdleScavengeThreshold),
+        memory_reducer_mark_compacts_left_(0),
+        memory_reducer_active_(false) {}
+
+  // Returns the garbage collection operation that fits into the given idle
+  // time.
+  GCIdleTimeAction Compute(size_t idle_time_in_ms, HeapState heap_state);
+
+  void NotifyIdleMarkCompact() {
+    if (memory_reducer_mark_compacts_left_ > 0) {
+      --memory_reducer_mark_compacts_left_;
+    }
+    if (mark_compacts_since_idle_round_started_ < kMaxMarkCompactsInIdleRound) {
+      ++mark_compacts_since_idle_round_started_;
+      if (mark_compacts_since_idle_round_started_ ==
+          kMaxMarkCompactsInIdleRound) {
+        scavenges_since_last_idle_round_ = 0;
+      }
+    }
+  }
+
+  void NotifyScavenge() { ++scavenges_since_last_idle_round_; }
+
+  bool IsIdleRoundFinished() {
+    return mark_compacts_since_idle_round_started_ ==
+           kMaxMarkCompactsInIdleRound;
+  }
+
+  // The memory reducer spends the following idle notifications on a few
+  // compacting mark-compacts and then releases the unused memory. It is
+  // started when the embedder expects the isolate to stay idle for a long
+  // time.
+  void StartMemoryReducer() {
+    StartIdleRound();
+    memory_reducer_mark_compacts_left_ = kMemoryReducerMarkCompacts;
+    memory_reducer_active_ = true;
+  }
+
+  bool IsMemoryReducerActive() { return memory_reducer_active_; }
+
+  static size_t EstimateMarkingStepSize(size_t idle_time_in_ms,
+                                        size_t marking_speed_in_bytes_per_ms);
+
+  static size_t EstimateMarkCompactTime(
+      size_t size_of_objects, size_t mark_compact_speed_in_bytes_per_ms);
+
+  static size_t EstimateScavengeTime(size_t new_space_size,
+                                     size_t scavenger_speed_in_bytes_per_ms);
+
+  static bool ScavengeMayHappenSoon(size_t used_new_space_size,
+                                    size_t new_space_capacity);
+
  private:
+  GCIdleTimeAction ComputeMemoryReducerAction(size_t idle_time_in_ms,
+                                              HeapState heap_state);
+
+  void StartIdleRound() { mark_compacts_since_idle_round_started_ = 0; }
+
+  void FinishIdleRound() {
+    mark_compacts_since_idle_round_started_ = kMaxMarkCompactsInIdleRound;
+    scavenges_since_last_idle_round_ = 0;
+  }
+
+  bool EnoughGarbageSinceLastIdleRound() {
+    return scavenges_since_last_idle_round_ >= kIdleScavengeThreshold;
+  }
+
+  int mark_compacts_since_idle_round_started_;
+  int scavenges_since_last_idle_round_;
+  int memory_reducer_mark_compacts_left_;
+  bool memory_reducer_active_;
+
   DISALLOW_COPY_AND_ASSIGN(GCIdleTimeHandler);
 };
 
@@ -252,6 +252,7 @@ void GCTracer::PrintNVP() const {
 
   PrintF("external=%.1f ", current_.scopes[Scope::EXTERNAL]);
   PrintF("mark=%.1f ", current_.scopes[Scope::MC_MARK]);
+  PrintF("markparallel=%.1f ", current_.scopes[Scope::MC_MARK_PARALLEL]);
   PrintF("sweep=%.2f ", current_.scopes[Scope::MC_SWEEP]);
   PrintF("sweepns=%.2f ", current_.scopes[Scope::MC_SWEEP_NEWSPACE]);
   PrintF("sweepos=%.2f ", current_.scopes[Scope::MC_SWEEP_OLDSPACE]);
@@ -277,6 +278,8 @@ void GCTracer::PrintNVP() const {
          current_.scopes[Scope::MC_WEAKCOLLECTION_CLEAR]);
   PrintF("weakcollection_abort=%.1f ",
          current_.scopes[Scope::MC_WEAKCOLLECTION_ABORT]);
+  PrintF("scavenge_old_new=%.1f ",
+         current_.scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS]);
 
   PrintF("total_size_before=%" V8_PTR_PREFIX "d ", current_.start_object_size);
   PrintF("total_size_after=%" V8_PTR_PREFIX "d ", current_.end_object_size);
@@ -418,5 +421,22 @@ intptr_t GCTracer::ScavengeSpeedInBytesPerMillisecond() const {
 
   return static_cast<intptr_t>(bytes / durations);
 }
+
+
+intptr_t GCTracer::MarkCompactSpeedInBytesPerMillisecond() const {
+  intptr_t bytes = 0;
+  double durations = 0.0;
+  EventBuffer::const_iterator iter = mark_compactor_events_.begin();
+  while (iter != mark_compactor_events_.end()) {
+    bytes += iter->start_object_size;
+    durations += iter->end_time - iter->start_time +
+                 iter->pure_incremental_marking_duration;
+    ++iter;
+  }
+
+  if (durations == 0.0) return 0;
+
+  return static_cast<intptr_t>(bytes / durations);
+}
 }
 }  // namespace v8::internal
@@ -88,6 +88,7 @@ class GCTracer BASE_EMBEDDED {
     enum ScopeId {
       EXTERNAL,
       MC_MARK,
+      MC_MARK_PARALLEL,
       MC_SWEEP,
       MC_SWEEP_NEWSPACE,
       MC_SWEEP_OLDSPACE,
@@ -105,6 +106,7 @@ class GCTracer BASE_EMBEDDED {
       MC_WEAKCOLLECTION_CLEAR,
       MC_WEAKCOLLECTION_ABORT,
       MC_FLUSH_CODE,
+      SCAVENGER_OLD_TO_NEW_POINTERS,
       NUMBER_OF_SCOPES
     };
 
@@ -291,6 +293,11 @@ class GCTracer BASE_EMBEDDED {
   // Returns 0 if no events have been recorded.
   intptr_t ScavengeSpeedInBytesPerMillisecond() const;
 
+  // Compute the average mark-compact speed in bytes/millisecond, including
+  // the incremental marking work done for each mark-compact.
+  // Returns 0 if no events have been recorded.
+  intptr_t MarkCompactSpeedInBytesPerMillisecond() const;
+
  private:
   // Print one detailed trace line in name=value format.
   // TODO(ernstm): Move to Heap.
@@ -700,6 +700,31 @@ void IncrementalMarking::ProcessMarkingDeque() {
 }
 
 
+void IncrementalMarking::TransferMarkingDeque(MarkingDeque* deque) {
+  Map* filler_map = heap_->one_pointer_filler_map();
+  while (!marking_deque_.IsEmpty()) {
+    HeapObject* obj = marking_deque_.Pop();
+
+    // Explicitly skip one word fillers. Incremental markbit patterns are
+    // correct only for objects that occupy at least two words.
+    Map* map = obj->map();
+    if (map == filler_map) continue;
+
+    // Objects that were trimmed into fillers after being pushed stay white.
+    MarkBit mark_bit = Marking::MarkBitFrom(obj);
+    if (Marking::IsWhite(mark_bit)) {
+      DCHECK(obj->IsFiller());
+      continue;
+    }
+
+    // Black objects on the deque are large arrays that were only partially
+    // scanned using the progress bar. The full collector scans them again.
+    MarkBlackOrKeepBlack(obj, mark_bit, obj->SizeFromMap(map));
+    deque->PushBlack(obj);
+  }
+}
+
+
 void IncrementalMarking::Hurry() {
   if (state() == MARKING) {
     double start = 0.0;
@@ -14,6 +14,10 @@ namespace v8 {
 namespace internal {
 
 
+// Incremental marking runs in steps on the main thread, interleaved with the
+// mutator; there is no concurrent marking while JavaScript runs. With
+// --parallel-marking only the finalizing full collection shares the work
+// left on the marking deque with background tasks.
 class IncrementalMarking {
  public:
   enum State { STOPPED, SWEEPING, MARKING, COMPLETE };
@@ -56,6 +60,11 @@ class IncrementalMarking {
 
   void Hurry();
 
+  // Moves the objects left on the marking deque to the given deque of the
+  // full collector, which can then finish marking in parallel instead of
+  // Hurry() doing it on the main thread. Grey objects are marked black.
+  void TransferMarkingDeque(MarkingDeque* deque);
+
   void Finalize();
 
   void Abort();
@@ -33,6 +33,10 @@ void MarkCompactCollector::SetFlags(int flags) {
 void MarkCompactCollector::MarkObject(HeapObject* obj, MarkBit mark_bit) {
   DCHECK(Marking::MarkBitFrom(obj) == mark_bit);
   if (!mark_bit.Get()) {
+    if (is_marking_in_parallel()) {
+      if (SetMarkAtomically(obj, mark_bit)) main_thread_marking_->Push(obj);
+      return;
+    }
     mark_bit.Set();
     MemoryChunk::IncrementLiveBytesFromGC(obj->address(), obj->Size());
     DCHECK(IsMarked(obj));
@@ -50,6 +54,15 @@ void MarkCompactCollector::SetMark(HeapObject* obj, MarkBit mark_bit) {
 }
 
 
+bool MarkCompactCollector::SetMarkAtomically(HeapObject* obj,
+                                             MarkBit mark_bit) {
+  DCHECK(Marking::MarkBitFrom(obj) == mark_bit);
+  if (!mark_bit.SetAtomic()) return false;
+  MemoryChunk::IncrementLiveBytesFromParallelGC(obj->address(), obj->Size());
+  return true;
+}
+
+
 bool MarkCompactCollector::IsMarked(Object* obj) {
   DCHECK(obj->IsHeapObject());
   HeapObject* heap_object = HeapObject::cast(obj);
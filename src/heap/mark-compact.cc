@@ -18,7 +18,6 @@
 #include "src/heap/objects-visiting.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/spaces-inl.h"
-#include "src/heap/sweeper-thread.h"
 #include "src/heap-profiler.h"
 #include "src/ic-inl.h"
 #include "src/stub-cache.h"
@@ -48,7 +47,11 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       compacting_(false),
       was_marked_incrementally_(false),
       sweeping_in_progress_(false),
+      pending_sweeper_jobs_(0),
       pending_sweeper_jobs_semaphore_(0),
+      use_parallel_marking_(false),
+      main_thread_marking_(NULL),
+      pending_marking_tasks_semaphore_(0),
       sequential_sweeping_(false),
       migration_slots_buffer_(NULL),
       heap_(heap),
@@ -330,6 +333,7 @@ static void VerifyNativeContextSeparation(Heap* heap) {
 void MarkCompactCollector::SetUp() {
   free_list_old_data_space_.Reset(new FreeList(heap_->old_data_space()));
   free_list_old_pointer_space_.Reset(new FreeList(heap_->old_pointer_space()));
+  free_list_map_space_.Reset(new FreeList(heap_->map_space()));
 }
 
 
@@ -488,10 +492,17 @@ void MarkCompactCollector::VerifyWeakEmbeddedObjectsInCode() {
 
 
 void MarkCompactCollector::VerifyOmittedMapChecks() {
-  HeapObjectIterator iterator(heap()->map_space());
-  for (HeapObject* obj = iterator.Next(); obj != NULL; obj = iterator.Next()) {
-    Map* map = Map::cast(obj);
-    map->VerifyOmittedMapChecks();
+  // Map space is swept concurrently, skip pages owned by sweeper tasks.
+  PageIterator it(heap()->map_space());
+  while (it.has_next()) {
+    Page* p = it.next();
+    if (!p->SweepingCompleted()) continue;
+    HeapObjectIterator iterator(p, NULL);
+    for (HeapObject* obj = iterator.Next(); obj != NULL;
+         obj = iterator.Next()) {
+      Map* map = Map::cast(obj);
+      map->VerifyOmittedMapChecks();
+    }
   }
 }
 #endif  // VERIFY_HEAP
@@ -555,52 +566,42 @@ class MarkCompactCollector::SweeperTask : public v8::Task {
 };
 
 
-void MarkCompactCollector::StartSweeperThreads() {
-  DCHECK(free_list_old_pointer_space_.get()->IsEmpty());
-  DCHECK(free_list_old_data_space_.get()->IsEmpty());
+void MarkCompactCollector::StartSweeperTask(PagedSpace* space) {
   sweeping_in_progress_ = true;
-  for (int i = 0; i < isolate()->num_sweeper_threads(); i++) {
-    isolate()->sweeper_threads()[i]->StartSweeping();
-  }
-  if (FLAG_job_based_sweeping) {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new SweeperTask(heap(), heap()->old_data_space()),
-        v8::Platform::kShortRunningTask);
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new SweeperTask(heap(), heap()->old_pointer_space()),
-        v8::Platform::kShortRunningTask);
-  }
+  pending_sweeper_jobs_++;
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new SweeperTask(heap(), space), v8::Platform::kShortRunningTask);
 }
 
 
 void MarkCompactCollector::EnsureSweepingCompleted() {
   DCHECK(sweeping_in_progress_ == true);
 
-  // If sweeping is not completed, we try to complete it here. If we do not
-  // have sweeper threads we have to complete since we do not have a good
-  // indicator for a swept space in that case.
-  if (!AreSweeperThreadsActivated() || !IsSweepingCompleted()) {
+  // If sweeping is not completed, we try to complete it here, so that we do
+  // not have to wait for tasks that the platform did not schedule yet.
+  if (!IsSweepingCompleted()) {
     SweepInParallel(heap()->paged_space(OLD_DATA_SPACE), 0);
     SweepInParallel(heap()->paged_space(OLD_POINTER_SPACE), 0);
+    SweepInParallel(heap()->paged_space(MAP_SPACE), 0);
   }
 
-  for (int i = 0; i < isolate()->num_sweeper_threads(); i++) {
-    isolate()->sweeper_threads()[i]->WaitForSweeperThread();
-  }
-  if (FLAG_job_based_sweeping) {
-    // Wait twice for both jobs.
-    pending_sweeper_jobs_semaphore_.Wait();
+  for (int i = 0; i < pending_sweeper_jobs_; i++) {
     pending_sweeper_jobs_semaphore_.Wait();
   }
+  pending_sweeper_jobs_ = 0;
   ParallelSweepSpacesComplete();
   sweeping_in_progress_ = false;
   RefillFreeList(heap()->paged_space(OLD_DATA_SPACE));
   RefillFreeList(heap()->paged_space(OLD_POINTER_SPACE));
+  RefillFreeList(heap()->paged_space(MAP_SPACE));
   heap()->paged_space(OLD_DATA_SPACE)->ResetUnsweptFreeBytes();
   heap()->paged_space(OLD_POINTER_SPACE)->ResetUnsweptFreeBytes();
+  heap()->paged_space(MAP_SPACE)->ResetUnsweptFreeBytes();
 
 #ifdef VERIFY_HEAP
-  if (FLAG_verify_heap) {
+  // Parallel sweeping completes in the middle of a mark-compact, before the
+  // heap is evacuated.
+  if (FLAG_verify_heap && heap()->gc_state() == Heap::NOT_IN_GC) {
     VerifyEvacuation(heap_);
   }
 #endif
@@ -608,21 +609,17 @@ void MarkCompactCollector::EnsureSweepingCompleted() {
 
 
 bool MarkCompactCollector::IsSweepingCompleted() {
-  for (int i = 0; i < isolate()->num_sweeper_threads(); i++) {
-    if (!isolate()->sweeper_threads()[i]->SweepingCompleted()) {
-      return false;
-    }
-  }
-
-  if (FLAG_job_based_sweeping) {
-    if (!pending_sweeper_jobs_semaphore_.WaitFor(
-            base::TimeDelta::FromSeconds(0))) {
-      return false;
-    }
+  int finished_jobs = 0;
+  while (finished_jobs < pending_sweeper_jobs_ &&
+         pending_sweeper_jobs_semaphore_.WaitFor(
+             base::TimeDelta::FromSeconds(0))) {
+    finished_jobs++;
+  }
+  // Give the signals back, EnsureSweepingCompleted consumes them.
+  for (int i = 0; i < finished_jobs; i++) {
     pending_sweeper_jobs_semaphore_.Signal();
   }
-
-  return true;
+  return finished_jobs == pending_sweeper_jobs_;
 }
 
 
@@ -633,23 +630,20 @@ void MarkCompactCollector::RefillFreeList(PagedSpace* space) {
     free_list = free_list_old_pointer_space_.get();
   } else if (space == heap()->old_data_space()) {
     free_list = free_list_old_data_space_.get();
+  } else if (space == heap()->map_space()) {
+    free_list = free_list_map_space_.get();
   } else {
     // Any PagedSpace might invoke RefillFreeLists, so we need to make sure
-    // to only refill them for old data and pointer spaces.
+    // to only refill them for spaces that are swept concurrently.
     return;
   }
 
-  intptr_t freed_bytes = space->free_list()->Concatenate(free_list);
+  intptr_t freed_bytes = space->free_list()->TakeConcurrentlyAdded(free_list);
   space->AddToAccountingStats(freed_bytes);
   space->DecrementUnsweptFreeBytes(freed_bytes);
 }
 
 
-bool MarkCompactCollector::AreSweeperThreadsActivated() {
-  return isolate()->sweeper_threads() != NULL || FLAG_job_based_sweeping;
-}
-
-
 void Marking::TransferMark(Address old_start, Address new_start) {
   // This is only used when resizing an object.
   DCHECK(MemoryChunk::FromAddress(old_start) ==
@@ -945,7 +939,7 @@ void MarkCompactCollector::Prepare() {
   DCHECK(!FLAG_never_compact || !FLAG_always_compact);
 
   if (sweeping_in_progress()) {
-    // Instead of waiting we could also abort the sweeper threads here.
+    // Instead of waiting we could also abort the sweeper tasks here.
     EnsureSweepingCompleted();
   }
 
@@ -1379,11 +1373,13 @@ class MarkCompactMarkingVisitor
   INLINE(static void VisitPointers(Heap* heap, Object** start, Object** end)) {
     // Mark all objects pointed to in [start, end).
     const int kMinRangeForMarkingRecursion = 64;
-    if (end - start >= kMinRangeForMarkingRecursion) {
+    MarkCompactCollector* collector = heap->mark_compact_collector();
+    // Recursive marking assumes that nobody else marks the visited objects.
+    if (end - start >= kMinRangeForMarkingRecursion &&
+        !collector->is_marking_in_parallel()) {
       if (VisitUnmarkedObjects(heap, start, end)) return;
       // We are close to a stack overflow, so just mark the objects.
     }
-    MarkCompactCollector* collector = heap->mark_compact_collector();
     for (Object** p = start; p < end; p++) {
       MarkObjectByPointer(collector, start, p);
     }
@@ -1400,7 +1396,11 @@ class MarkCompactMarkingVisitor
   INLINE(static bool MarkObjectWithoutPush(Heap* heap, HeapObject* object)) {
     MarkBit mark_bit = Marking::MarkBitFrom(object);
     if (!mark_bit.Get()) {
-      heap->mark_compact_collector()->SetMark(object, mark_bit);
+      MarkCompactCollector* collector = heap->mark_compact_collector();
+      if (collector->is_marking_in_parallel()) {
+        return MarkCompactCollector::SetMarkAtomically(object, mark_bit);
+      }
+      collector->SetMark(object, mark_bit);
       return true;
     }
     return false;
@@ -1805,8 +1805,9 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkCompactMarkingVisitor::IterateBody(map, object);
 
     // Mark all the objects reachable from the map and body.  May leave
-    // overflowed objects in the heap.
-    collector_->EmptyMarkingDeque();
+    // overflowed objects in the heap.  Parallel marking is not started for
+    // every single root, callers process the marking deque afterwards.
+    if (!collector_->use_parallel_marking_) collector_->EmptyMarkingDeque();
   }
 
   MarkCompactCollector* collector_;
@@ -2135,6 +2136,10 @@ void MarkCompactCollector::MarkWeakObjectToCodeTable() {
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
 void MarkCompactCollector::EmptyMarkingDeque() {
+  if (use_parallel_marking_) {
+    EmptyMarkingDequeInParallel();
+    return;
+  }
   while (!marking_deque_.IsEmpty()) {
     HeapObject* object = marking_deque_.Pop();
     DCHECK(object->IsHeapObject());
@@ -2150,6 +2155,338 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 }
 
 
+// Marks objects on behalf of the background tasks of ParallelMarking. Only
+// objects whose marking visitor does nothing but mark the objects referenced
+// from one contiguous range of fields are visited here.
+class ParallelMarkingVisitor : public AllStatic {
+ public:
+  static bool CanVisit(Map* map) {
+    int id = map->visitor_id();
+    switch (id) {
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFreeSpace:
+      case StaticVisitorBase::kVisitFixedArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+      case StaticVisitorBase::kVisitFixedTypedArray:
+      case StaticVisitorBase::kVisitFixedFloat64Array:
+      case StaticVisitorBase::kVisitConsString:
+      case StaticVisitorBase::kVisitSlicedString:
+      case StaticVisitorBase::kVisitSymbol:
+      case StaticVisitorBase::kVisitOddball:
+      case StaticVisitorBase::kVisitCell:
+        return true;
+      default:
+        return IsDataObject(id) || IsJSObject(id) || IsStruct(id);
+    }
+  }
+
+  static void Visit(ParallelMarking::Local* local, Map* map,
+                    HeapObject* object) {
+    DCHECK(CanVisit(map));
+    int id = map->visitor_id();
+    switch (id) {
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitConsString:
+        VisitFixedBody<ConsString::BodyDescriptor>(local, object);
+        return;
+      case StaticVisitorBase::kVisitSlicedString:
+        VisitFixedBody<SlicedString::BodyDescriptor>(local, object);
+        return;
+      case StaticVisitorBase::kVisitSymbol:
+        VisitFixedBody<Symbol::BodyDescriptor>(local, object);
+        return;
+      case StaticVisitorBase::kVisitOddball:
+        VisitFixedBody<Oddball::BodyDescriptor>(local, object);
+        return;
+      case StaticVisitorBase::kVisitCell:
+        VisitFixedBody<Cell::BodyDescriptor>(local, object);
+        return;
+      case StaticVisitorBase::kVisitFixedArray:
+        VisitFlexibleBody<FixedArray::BodyDescriptor>(local, map, object);
+        return;
+      default:
+        if (IsJSObject(id)) {
+          VisitFlexibleBody<JSObject::BodyDescriptor>(local, map, object);
+        } else if (IsStruct(id)) {
+          VisitFlexibleBody<StructBodyDescriptor>(local, map, object);
+        }
+        // Data objects contain no pointers.
+        return;
+    }
+  }
+
+ private:
+  static bool IsDataObject(int id) {
+    return id >= StaticVisitorBase::kVisitDataObject &&
+           id <= StaticVisitorBase::kVisitDataObjectGeneric;
+  }
+
+  static bool IsJSObject(int id) {
+    return id >= StaticVisitorBase::kVisitJSObject &&
+           id <= StaticVisitorBase::kVisitJSObjectGeneric;
+  }
+
+  static bool IsStruct(int id) {
+    return id >= StaticVisitorBase::kVisitStruct &&
+           id <= StaticVisitorBase::kVisitStructGeneric;
+  }
+
+  template <typename BodyDescriptor>
+  INLINE(static void VisitFixedBody(ParallelMarking::Local* local,
+                                    HeapObject* object)) {
+    VisitPointers(local, object, BodyDescriptor::kStartOffset,
+                  BodyDescriptor::kEndOffset);
+  }
+
+  template <typename BodyDescriptor>
+  INLINE(static void VisitFlexibleBody(ParallelMarking::Local* local, Map* map,
+                                       HeapObject* object)) {
+    VisitPointers(local, object, BodyDescriptor::kStartOffset,
+                  BodyDescriptor::SizeOf(map, object));
+  }
+
+  INLINE(static void VisitPointers(ParallelMarking::Local* local,
+                                   HeapObject* host, int start_offset,
+                                   int end_offset)) {
+    Object** start = HeapObject::RawField(host, start_offset);
+    Object** end = HeapObject::RawField(host, end_offset);
+    bool record_slots =
+        !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host);
+    for (Object** p = start; p < end; p++) {
+      if (!(*p)->IsHeapObject()) continue;
+      HeapObject* object = ShortCircuitConsString(p);
+      if (record_slots &&
+          MarkCompactCollector::IsOnEvacuationCandidate(object)) {
+        local->RecordSlot(p);
+      }
+      MarkBit mark_bit = Marking::MarkBitFrom(object);
+      if (!mark_bit.Get() &&
+          MarkCompactCollector::SetMarkAtomically(object, mark_bit)) {
+        local->Push(object);
+      }
+    }
+  }
+};
+
+
+class MarkCompactCollector::MarkingTask : public v8::Task {
+ public:
+  MarkingTask(Heap* heap, ParallelMarking* marking)
+      : heap_(heap), marking_(marking) {}
+
+  virtual ~MarkingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    if (marking_->EnterTask()) {
+      ParallelMarking::Local local(marking_, false);
+      HeapObject* object;
+      while ((object = local.Pop()) != NULL) {
+        Map* map = object->map();
+        MarkBit map_mark = Marking::MarkBitFrom(map);
+        if (!map_mark.Get() && SetMarkAtomically(map, map_mark)) {
+          local.PushBailout(map);
+        }
+        if (ParallelMarkingVisitor::CanVisit(map)) {
+          ParallelMarkingVisitor::Visit(&local, map, object);
+        } else {
+          local.PushBailout(object);
+        }
+      }
+    }
+    heap_->mark_compact_collector()->pending_marking_tasks_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  ParallelMarking* marking_;
+
+  DISALLOW_COPY_AND_ASSIGN(MarkingTask);
+};
+
+
+ParallelMarking::Local::Local(ParallelMarking* marking, bool is_main_thread)
+    : marking_(marking),
+      is_main_thread_(is_main_thread),
+      current_(new Segment()),
+      bailouts_(new Segment()) {}
+
+
+ParallelMarking::Local::~Local() {
+  DCHECK(current_->IsEmpty());
+  DCHECK(bailouts_->IsEmpty());
+  delete current_;
+  delete bailouts_;
+  if (!recorded_slots_.is_empty()) {
+    marking_->PublishRecordedSlots(&recorded_slots_);
+  }
+}
+
+
+HeapObject* ParallelMarking::Local::Pop() {
+  if (current_->IsEmpty()) {
+    // Bailouts have to be published before waiting for work, otherwise the
+    // main thread might wait for them forever.
+    if (!bailouts_->IsEmpty()) {
+      marking_->PublishBailouts(bailouts_);
+      bailouts_ = new Segment();
+    }
+    Segment* segment = marking_->Steal(is_main_thread_);
+    if (segment == NULL) return NULL;
+    delete current_;
+    current_ = segment;
+  }
+  return current_->Pop();
+}
+
+
+ParallelMarking::ParallelMarking(MarkCompactCollector* collector,
+                                 int number_of_tasks)
+    : collector_(collector),
+      number_of_tasks_(number_of_tasks),
+      tasks_posted_(0),
+      pool_(NULL),
+      bailouts_(NULL),
+      active_participants_(1),
+      idle_participants_(0),
+      done_(false) {}
+
+
+ParallelMarking::~ParallelMarking() {
+  DCHECK(pool_ == NULL);
+  DCHECK(bailouts_ == NULL);
+}
+
+
+bool ParallelMarking::EnterTask() {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  if (done_) return false;
+  active_participants_++;
+  return true;
+}
+
+
+void ParallelMarking::Publish(Segment* segment) {
+  DCHECK(!segment->IsEmpty());
+  {
+    base::LockGuard<base::Mutex> lock_guard(&mutex_);
+    segment->set_next(pool_);
+    pool_ = segment;
+    work_available_.NotifyOne();
+  }
+  // Background tasks are only started once there is work to share. The first
+  // segment is always published by the main thread.
+  if (tasks_posted_ == 0 && number_of_tasks_ > 0) PostTasks();
+}
+
+
+void ParallelMarking::PublishBailouts(Segment* segment) {
+  DCHECK(!segment->IsEmpty());
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  segment->set_next(bailouts_);
+  bailouts_ = segment;
+  // Make sure the main thread wakes up.
+  work_available_.NotifyAll();
+}
+
+
+void ParallelMarking::PublishRecordedSlots(List<Object**>* slots) {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  recorded_slots_.AddAll(*slots);
+}
+
+
+ParallelMarking::Segment* ParallelMarking::Steal(bool is_main_thread) {
+  base::LockGuard<base::Mutex> lock_guard(&mutex_);
+  while (true) {
+    Segment* segment = NULL;
+    if (is_main_thread && bailouts_ != NULL) {
+      segment = bailouts_;
+      bailouts_ = segment->next();
+    } else if (pool_ != NULL) {
+      segment = pool_;
+      pool_ = segment->next();
+    }
+    if (segment != NULL) {
+      segment->set_next(NULL);
+      return segment;
+    }
+    if (done_) return NULL;
+    // Pending bailouts keep the main thread busy, so marking cannot have
+    // terminated yet even if it has not woken up to take them.
+    if (++idle_participants_ == active_participants_ && bailouts_ == NULL) {
+      done_ = true;
+      work_available_.NotifyAll();
+      return NULL;
+    }
+    work_available_.Wait(&mutex_);
+    idle_participants_--;
+  }
+}
+
+
+void ParallelMarking::PostTasks() {
+  DCHECK_EQ(0, tasks_posted_);
+  // Set before posting, so that tasks publishing work do not post again.
+  tasks_posted_ = number_of_tasks_;
+  for (int i = 0; i < number_of_tasks_; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new MarkCompactCollector::MarkingTask(collector_->heap(), this),
+        v8::Platform::kShortRunningTask);
+  }
+}
+
+
+List<Object**>* ParallelMarking::WaitForTasks() {
+  for (int i = 0; i < tasks_posted_; i++) {
+    collector_->pending_marking_tasks_semaphore_.Wait();
+  }
+  return &recorded_slots_;
+}
+
+
+int MarkCompactCollector::NumberOfParallelMarkingTasks() {
+  return Max(isolate()->max_available_threads() - 1, 0);
+}
+
+
+void MarkCompactCollector::EmptyMarkingDequeInParallel() {
+  DCHECK(!is_marking_in_parallel());
+  if (marking_deque_.IsEmpty()) return;
+  GCTracer::Scope gc_scope(heap()->tracer(), GCTracer::Scope::MC_MARK_PARALLEL);
+  ParallelMarking marking(this, NumberOfParallelMarkingTasks());
+  {
+    ParallelMarking::Local local(&marking, true);
+    while (!marking_deque_.IsEmpty()) local.Push(marking_deque_.Pop());
+    // While marking runs in parallel, MarkObject pushes onto the main
+    // thread's private stack instead of the marking deque.
+    main_thread_marking_ = &local;
+    HeapObject* object;
+    while ((object = local.Pop()) != NULL) {
+      DCHECK(heap()->Contains(object));
+      DCHECK(Marking::IsBlack(Marking::MarkBitFrom(object)));
+
+      Map* map = object->map();
+      MarkBit map_mark = Marking::MarkBitFrom(map);
+      MarkObject(map, map_mark);
+
+      MarkCompactMarkingVisitor::IterateBody(map, object);
+    }
+    main_thread_marking_ = NULL;
+  }
+  List<Object**>* slots = marking.WaitForTasks();
+  for (int i = 0; i < slots->length(); i++) {
+    Object** slot = slots->at(i);
+    // The main thread may have overwritten the slot in the meantime, e.g.
+    // when flushing regexp code.
+    if ((*slot)->IsHeapObject()) RecordSlot(slot, slot, *slot);
+  }
+}
+
+
 // Sweep the heap for overflowed objects, clear their overflow bits, and
 // push them on the marking stack.  Stop early if the marking stack fills
 // before sweeping completes.  If sweeping completes, there are no remaining
@@ -2247,9 +2584,30 @@ void MarkCompactCollector::MarkLiveObjects() {
   // with the C stack limit check.
   PostponeInterruptsScope postpone(isolate());
 
+  // Object statistics are collected by the marking visitor on the main
+  // thread only.
+  use_parallel_marking_ = FLAG_parallel_marking &&
+                          !FLAG_track_gc_object_stats &&
+                          NumberOfParallelMarkingTasks() > 0;
+
+  // The to space contains live objects, a page in from space is used as a
+  // marking stack.
+  Address marking_deque_start = heap()->new_space()->FromSpacePageLow();
+  Address marking_deque_end = heap()->new_space()->FromSpacePageHigh();
+  if (FLAG_force_marking_deque_overflows) {
+    marking_deque_end = marking_deque_start + 64 * kPointerSize;
+  }
+  marking_deque_.Initialize(marking_deque_start, marking_deque_end);
+  DCHECK(!marking_deque_.overflowed());
+
   bool incremental_marking_overflowed = false;
   IncrementalMarking* incremental_marking = heap_->incremental_marking();
   if (was_marked_incrementally_) {
+    // The work left over by the incremental marker is done by the parallel
+    // marker, which keeps the finalization pause short.
+    if (use_parallel_marking_) {
+      incremental_marking->TransferMarkingDeque(&marking_deque_);
+    }
     // Finalize the incremental marking and check whether we had an overflow.
     // Both markers use grey color to mark overflowed objects so
     // non-incremental marker can deal with them as if overflow
@@ -2269,16 +2627,6 @@ void MarkCompactCollector::MarkLiveObjects() {
   DCHECK(state_ == PREPARE_GC);
   state_ = MARK_LIVE_OBJECTS;
 #endif
-  // The to space contains live objects, a page in from space is used as a
-  // marking stack.
-  Address marking_deque_start = heap()->new_space()->FromSpacePageLow();
-  Address marking_deque_end = heap()->new_space()->FromSpacePageHigh();
-  if (FLAG_force_marking_deque_overflows) {
-    marking_deque_end = marking_deque_start + 64 * kPointerSize;
-  }
-  marking_deque_.Initialize(marking_deque_start, marking_deque_end);
-  DCHECK(!marking_deque_.overflowed());
-
   if (incremental_marking_overflowed) {
     // There are overflowed objects left in the heap after incremental marking.
     marking_deque_.SetOverflowed();
@@ -2334,15 +2682,14 @@ void MarkCompactCollector::MarkLiveObjects() {
       &IsUnmarkedHeapObject);
   // Then we mark the objects and process the transitive closure.
   heap()->isolate()->global_handles()->IterateWeakRoots(&root_visitor);
-  while (marking_deque_.overflowed()) {
-    RefillMarkingDeque();
-    EmptyMarkingDeque();
-  }
+  ProcessMarkingDeque();
 
   // Repeat host application specific and Harmony weak maps marking to
   // mark unmarked objects reachable from the weak roots.
   ProcessEphemeralMarking(&root_visitor);
 
+  use_parallel_marking_ = false;
+
   AfterMarking();
 
   if (FLAG_print_cumulative_gc_stat) {
@@ -3511,6 +3858,101 @@ void MarkCompactCollector::ProcessInvalidatedCode(ObjectVisitor* visitor) {
 }
 
 
+// Updates pointers to evacuated objects on the main thread and on background
+// tasks (--parallel-pointer-update). The work items are to-space pages and
+// slots buffers. Every item is claimed by a single thread, so threads only
+// race on slots that were recorded in more than one buffer, and those get the
+// same forwarding address from all of them. Typed slots are left to the main
+// thread, see SlotsBuffer::SlotsToUpdate.
+class PointersUpdatingJob {
+ public:
+  PointersUpdatingJob(Heap* heap, bool code_slots_filtering_required)
+      : heap_(heap),
+        code_slots_filtering_required_(code_slots_filtering_required),
+        next_item_(0),
+        pending_tasks_semaphore_(0) {}
+
+  void AddPage(NewSpacePage* page) { pages_.Add(page); }
+
+  void AddSlotsBuffers(SlotsBuffer* buffer) {
+    for (; buffer != NULL; buffer = buffer->next()) buffers_.Add(buffer);
+  }
+
+  void Run() {
+    int number_of_items = pages_.length() + buffers_.length();
+    int number_of_tasks = heap_->isolate()->max_available_threads() - 1;
+    number_of_tasks = Max(Min(number_of_tasks, number_of_items - 1), 0);
+    for (int i = 0; i < number_of_tasks; i++) {
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          new Task(this), v8::Platform::kShortRunningTask);
+    }
+    ProcessItems();
+    for (int i = 0; i < number_of_tasks; i++) {
+      pending_tasks_semaphore_.Wait();
+    }
+  }
+
+ private:
+  class Task : public v8::Task {
+   public:
+    explicit Task(PointersUpdatingJob* job) : job_(job) {}
+
+    virtual ~Task() {}
+
+   private:
+    // v8::Task overrides.
+    virtual void Run() V8_OVERRIDE {
+      job_->ProcessItems();
+      job_->pending_tasks_semaphore_.Signal();
+    }
+
+    PointersUpdatingJob* job_;
+
+    DISALLOW_COPY_AND_ASSIGN(Task);
+  };
+
+  void ProcessItems() {
+    while (true) {
+      int index = base::NoBarrier_AtomicIncrement(&next_item_, 1) - 1;
+      if (index < pages_.length()) {
+        UpdatePointersOnPage(pages_[index]);
+        continue;
+      }
+      index -= pages_.length();
+      if (index >= buffers_.length()) return;
+      if (code_slots_filtering_required_) {
+        buffers_[index]->UpdateSlotsWithFilter(heap_,
+                                               SlotsBuffer::UNTYPED_SLOTS);
+      } else {
+        buffers_[index]->UpdateSlots(heap_, SlotsBuffer::UNTYPED_SLOTS);
+      }
+    }
+  }
+
+  void UpdatePointersOnPage(NewSpacePage* page) {
+    PointersUpdatingVisitor updating_visitor(heap_);
+    Address top = heap_->new_space()->top();
+    Address limit =
+        NewSpacePage::FromLimit(top) == page ? top : page->area_end();
+    SemiSpaceIterator it(page->area_start(), limit);
+    for (HeapObject* object = it.Next(); object != NULL; object = it.Next()) {
+      Map* map = object->map();
+      object->IterateBody(map->instance_type(), object->SizeFromMap(map),
+                          &updating_visitor);
+    }
+  }
+
+  Heap* heap_;
+  bool code_slots_filtering_required_;
+  List<NewSpacePage*> pages_;
+  List<SlotsBuffer*> buffers_;
+  base::Atomic32 next_item_;
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(PointersUpdatingJob);
+};
+
+
 void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
   Heap::RelocationLock relocation_lock(heap());
 
@@ -3535,13 +3977,21 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
     GCTracer::Scope gc_scope(heap()->tracer(),
                              GCTracer::Scope::MC_UPDATE_NEW_TO_NEW_POINTERS);
     // Update pointers in to space.
-    SemiSpaceIterator to_it(heap()->new_space()->bottom(),
-                            heap()->new_space()->top());
-    for (HeapObject* object = to_it.Next(); object != NULL;
-         object = to_it.Next()) {
-      Map* map = object->map();
-      object->IterateBody(map->instance_type(), object->SizeFromMap(map),
-                          &updating_visitor);
+    if (FLAG_parallel_pointer_update) {
+      PointersUpdatingJob job(heap(), false);
+      NewSpacePageIterator it(heap()->new_space()->bottom(),
+                              heap()->new_space()->top());
+      while (it.has_next()) job.AddPage(it.next());
+      job.Run();
+    } else {
+      SemiSpaceIterator to_it(heap()->new_space()->bottom(),
+                              heap()->new_space()->top());
+      for (HeapObject* object = to_it.Next(); object != NULL;
+           object = to_it.Next()) {
+        Map* map = object->map();
+        object->IterateBody(map->instance_type(), object->SizeFromMap(map),
+                            &updating_visitor);
+      }
     }
   }
 
@@ -3564,8 +4014,32 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
   {
     GCTracer::Scope gc_scope(heap()->tracer(),
                              GCTracer::Scope::MC_UPDATE_POINTERS_TO_EVACUATED);
-    SlotsBuffer::UpdateSlotsRecordedIn(heap_, migration_slots_buffer_,
-                                       code_slots_filtering_required);
+    if (FLAG_parallel_pointer_update) {
+      // The slots buffers of evacuation candidates are updated here as well,
+      // so that all untyped slots are handled by a single parallel job.
+      PointersUpdatingJob job(heap(), code_slots_filtering_required);
+      job.AddSlotsBuffers(migration_slots_buffer_);
+      for (int i = 0; i < evacuation_candidates_.length(); i++) {
+        Page* p = evacuation_candidates_[i];
+        if (p->IsEvacuationCandidate()) job.AddSlotsBuffers(p->slots_buffer());
+      }
+      job.Run();
+
+      SlotsBuffer::UpdateSlotsRecordedIn(heap_, migration_slots_buffer_,
+                                         code_slots_filtering_required,
+                                         SlotsBuffer::TYPED_SLOTS);
+      for (int i = 0; i < evacuation_candidates_.length(); i++) {
+        Page* p = evacuation_candidates_[i];
+        if (p->IsEvacuationCandidate()) {
+          SlotsBuffer::UpdateSlotsRecordedIn(heap_, p->slots_buffer(),
+                                             code_slots_filtering_required,
+                                             SlotsBuffer::TYPED_SLOTS);
+        }
+      }
+    } else {
+      SlotsBuffer::UpdateSlotsRecordedIn(heap_, migration_slots_buffer_,
+                                         code_slots_filtering_required);
+    }
     if (FLAG_trace_fragmentation) {
       PrintF("  migration slots buffer: %d\n",
              SlotsBuffer::SizeOfChain(migration_slots_buffer_));
@@ -3599,8 +4073,10 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
              p->IsFlagSet(Page::RESCAN_ON_EVACUATION));
 
       if (p->IsEvacuationCandidate()) {
-        SlotsBuffer::UpdateSlotsRecordedIn(heap_, p->slots_buffer(),
-                                           code_slots_filtering_required);
+        if (!FLAG_parallel_pointer_update) {
+          SlotsBuffer::UpdateSlotsRecordedIn(heap_, p->slots_buffer(),
+                                             code_slots_filtering_required);
+        }
         if (FLAG_trace_fragmentation) {
           PrintF("  page %p slots buffer: %d\n", reinterpret_cast<void*>(p),
                  SlotsBuffer::SizeOfChain(p->slots_buffer()));
@@ -4317,9 +4793,15 @@ int MarkCompactCollector::SweepInParallel(PagedSpace* space,
 int MarkCompactCollector::SweepInParallel(Page* page, PagedSpace* space) {
   int max_freed = 0;
   if (page->TryParallelSweeping()) {
-    FreeList* free_list = space == heap()->old_pointer_space()
-                              ? free_list_old_pointer_space_.get()
-                              : free_list_old_data_space_.get();
+    FreeList* free_list;
+    if (space == heap()->old_pointer_space()) {
+      free_list = free_list_old_pointer_space_.get();
+    } else if (space == heap()->old_data_space()) {
+      free_list = free_list_old_data_space_.get();
+    } else {
+      DCHECK(space == heap()->map_space());
+      free_list = free_list_map_space_.get();
+    }
     FreeList private_free_list(space);
     if (space->swept_precisely()) {
       max_freed = SweepPrecisely<SWEEP_ONLY, SWEEP_IN_PARALLEL,
@@ -4329,7 +4811,7 @@ int MarkCompactCollector::SweepInParallel(Page* page, PagedSpace* space) {
       max_freed = SweepConservatively<SWEEP_IN_PARALLEL>(
           space, &private_free_list, page);
     }
-    free_list->Concatenate(&private_free_list);
+    free_list->AddConcurrently(&private_free_list);
   }
   return max_freed;
 }
@@ -4351,6 +4833,16 @@ void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
   bool unused_page_present = false;
   bool parallel_sweeping_active = false;
 
+  // When reducing the memory footprint, no unused page is kept as long as
+  // another page of the space survives the collection.
+  if (reduce_memory_footprint_) {
+    PageIterator live_it(space);
+    while (live_it.has_next() && !unused_page_present) {
+      Page* p = live_it.next();
+      unused_page_present = p->LiveBytes() > 0 && !p->IsEvacuationCandidate();
+    }
+  }
+
   while (it.has_next()) {
     Page* p = it.next();
     DCHECK(p->parallel_sweeping() == MemoryChunk::SWEEPING_DONE);
@@ -4510,7 +5002,10 @@ void MarkCompactCollector::SweepSpaces() {
     }
 
     if (ShouldStartSweeperThreads(how_to_sweep)) {
-      StartSweeperThreads();
+      DCHECK(free_list_old_pointer_space_.get()->IsEmpty());
+      DCHECK(free_list_old_data_space_.get()->IsEmpty());
+      StartSweeperTask(heap()->old_data_space());
+      StartSweeperTask(heap()->old_pointer_space());
     }
 
     if (ShouldWaitForSweeperThreads(how_to_sweep)) {
@@ -4536,11 +5031,20 @@ void MarkCompactCollector::SweepSpaces() {
 
   // ClearNonLiveTransitions depends on precise sweeping of map space to
   // detect whether unmarked map became dead in this collection or in one
-  // of the previous ones.
+  // of the previous ones. Concurrent sweeping of map space is finished
+  // before the next collection starts marking.
   {
     GCTracer::Scope sweep_scope(heap()->tracer(),
                                 GCTracer::Scope::MC_SWEEP_MAP);
-    SweepSpace(heap()->map_space(), PRECISE);
+    if (ShouldStartSweeperThreads(how_to_sweep)) {
+      SweepSpace(heap()->map_space(), ShouldWaitForSweeperThreads(how_to_sweep)
+                                          ? PARALLEL_PRECISE
+                                          : CONCURRENT_PRECISE);
+      DCHECK(free_list_map_space_.get()->IsEmpty());
+      StartSweeperTask(heap()->map_space());
+    } else {
+      SweepSpace(heap()->map_space(), PRECISE);
+    }
   }
 
   // Deallocate unmarked objects and clear marked bits for marked objects.
@@ -4549,6 +5053,11 @@ void MarkCompactCollector::SweepSpaces() {
   // Deallocate evacuated candidate pages.
   ReleaseEvacuationCandidates();
 
+  // Parallel sweeping of map space has to be finished before the GC ends.
+  if (ShouldWaitForSweeperThreads(how_to_sweep) && sweeping_in_progress()) {
+    EnsureSweepingCompleted();
+  }
+
   if (FLAG_print_cumulative_gc_stat) {
     heap_->tracer()->AddSweepingTime(base::OS::TimeCurrentMillis() -
                                      start_time);
@@ -4576,6 +5085,7 @@ void MarkCompactCollector::ParallelSweepSpaceComplete(PagedSpace* space) {
 void MarkCompactCollector::ParallelSweepSpacesComplete() {
   ParallelSweepSpaceComplete(heap()->old_pointer_space());
   ParallelSweepSpaceComplete(heap()->old_data_space());
+  ParallelSweepSpaceComplete(heap()->map_space());
 }
 
 
@@ -4726,37 +5236,43 @@ static inline SlotsBuffer::SlotType DecodeSlotType(
 }
 
 
-void SlotsBuffer::UpdateSlots(Heap* heap) {
+void SlotsBuffer::UpdateSlots(Heap* heap, SlotsToUpdate slots_to_update) {
   PointersUpdatingVisitor v(heap);
 
   for (int slot_idx = 0; slot_idx < idx_; ++slot_idx) {
     ObjectSlot slot = slots_[slot_idx];
     if (!IsTypedSlot(slot)) {
-      PointersUpdatingVisitor::UpdateSlot(heap, slot);
+      if (slots_to_update != TYPED_SLOTS) {
+        PointersUpdatingVisitor::UpdateSlot(heap, slot);
+      }
     } else {
       ++slot_idx;
       DCHECK(slot_idx < idx_);
-      UpdateSlot(heap->isolate(), &v, DecodeSlotType(slot),
-                 reinterpret_cast<Address>(slots_[slot_idx]));
+      if (slots_to_update != UNTYPED_SLOTS) {
+        UpdateSlot(heap->isolate(), &v, DecodeSlotType(slot),
+                   reinterpret_cast<Address>(slots_[slot_idx]));
+      }
     }
   }
 }
 
 
-void SlotsBuffer::UpdateSlotsWithFilter(Heap* heap) {
+void SlotsBuffer::UpdateSlotsWithFilter(Heap* heap,
+                                        SlotsToUpdate slots_to_update) {
   PointersUpdatingVisitor v(heap);
 
   for (int slot_idx = 0; slot_idx < idx_; ++slot_idx) {
     ObjectSlot slot = slots_[slot_idx];
     if (!IsTypedSlot(slot)) {
-      if (!IsOnInvalidatedCodeObject(reinterpret_cast<Address>(slot))) {
+      if (slots_to_update != TYPED_SLOTS &&
+          !IsOnInvalidatedCodeObject(reinterpret_cast<Address>(slot))) {
         PointersUpdatingVisitor::UpdateSlot(heap, slot);
       }
     } else {
       ++slot_idx;
       DCHECK(slot_idx < idx_);
       Address pc = reinterpret_cast<Address>(slots_[slot_idx]);
-      if (!IsOnInvalidatedCodeObject(pc)) {
+      if (slots_to_update != UNTYPED_SLOTS && !IsOnInvalidatedCodeObject(pc)) {
         UpdateSlot(heap->isolate(), &v, DecodeSlotType(slot),
                    reinterpret_cast<Address>(slots_[slot_idx]));
       }
@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_MARK_COMPACT_H_
 #define V8_HEAP_MARK_COMPACT_H_
 
+#include "src/base/platform/condition-variable.h"
 #include "src/heap/spaces.h"
 
 namespace v8 {
@@ -292,9 +293,14 @@ class SlotsBuffer {
     return "UNKNOWN SlotType";
   }
 
-  void UpdateSlots(Heap* heap);
+  // Untyped slots of different buffers can be updated concurrently. Typed
+  // slots patch instruction streams and a code target might be recorded in
+  // more than one buffer, so they are updated on the main thread only.
+  enum SlotsToUpdate { ALL_SLOTS, UNTYPED_SLOTS, TYPED_SLOTS };
 
-  void UpdateSlotsWithFilter(Heap* heap);
+  void UpdateSlots(Heap* heap, SlotsToUpdate slots_to_update);
+
+  void UpdateSlotsWithFilter(Heap* heap, SlotsToUpdate slots_to_update);
 
   SlotsBuffer* next() { return next_; }
 
@@ -309,12 +315,13 @@ class SlotsBuffer {
   inline bool HasSpaceForTypedSlot() { return idx_ < kNumberOfElements - 1; }
 
   static void UpdateSlotsRecordedIn(Heap* heap, SlotsBuffer* buffer,
-                                    bool code_slots_filtering_required) {
+                                    bool code_slots_filtering_required,
+                                    SlotsToUpdate slots_to_update = ALL_SLOTS) {
     while (buffer != NULL) {
       if (code_slots_filtering_required) {
-        buffer->UpdateSlotsWithFilter(heap);
+        buffer->UpdateSlotsWithFilter(heap, slots_to_update);
       } else {
-        buffer->UpdateSlots(heap);
+        buffer->UpdateSlots(heap, slots_to_update);
       }
       buffer = buffer->next();
     }
@@ -486,6 +493,135 @@ class CodeFlusher {
 };
 
 
+// ParallelMarking distributes the transitive closure of a marking deque
+// over the main thread and a number of MarkingTasks running on the platform's
+// background threads (--parallel-marking). Every participant drains a private
+// stack of black objects and publishes surplus work in fixed-size segments to
+// a shared pool, from which idle participants steal. Mark bits and live bytes
+// are updated atomically while marking runs in parallel.
+//
+// Background tasks only visit objects whose visitation does nothing but mark
+// children and record slots. All other objects (maps, code, functions, weak
+// collections, ...) are handed back to the main thread, which visits them
+// with the regular marking visitor, so code flushing, weak references and
+// the collector's bookkeeping stay single-threaded.
+class ParallelMarking {
+ public:
+  class Segment : public Malloced {
+   public:
+    static const int kCapacity = 64;
+
+    Segment() : next_(NULL), size_(0) {}
+
+    bool IsEmpty() const { return size_ == 0; }
+    bool IsFull() const { return size_ == kCapacity; }
+
+    void Push(HeapObject* object) {
+      DCHECK(!IsFull());
+      objects_[size_++] = object;
+    }
+
+    HeapObject* Pop() {
+      DCHECK(!IsEmpty());
+      return objects_[--size_];
+    }
+
+    Segment* next() const { return next_; }
+    void set_next(Segment* next) { next_ = next; }
+
+   private:
+    Segment* next_;
+    int size_;
+    HeapObject* objects_[kCapacity];
+
+    DISALLOW_COPY_AND_ASSIGN(Segment);
+  };
+
+  // The private marking stack of one participant.
+  class Local {
+   public:
+    Local(ParallelMarking* marking, bool is_main_thread);
+    ~Local();
+
+    INLINE(void Push(HeapObject* object)) {
+      if (current_->IsFull()) {
+        marking_->Publish(current_);
+        current_ = new Segment();
+      }
+      current_->Push(object);
+    }
+
+    // Hands an object that may only be visited on the main thread back to it.
+    INLINE(void PushBailout(HeapObject* object)) {
+      DCHECK(!is_main_thread_);
+      if (bailouts_->IsFull()) {
+        marking_->PublishBailouts(bailouts_);
+        bailouts_ = new Segment();
+      }
+      bailouts_->Push(object);
+    }
+
+    // Slots recorded by background tasks are added to the slots buffers by
+    // the main thread once parallel marking has terminated.
+    void RecordSlot(Object** slot) { recorded_slots_.Add(slot); }
+
+    // Returns the next object to visit, stealing work from the shared pool
+    // if the private stack is empty. Returns NULL once all participants ran
+    // out of work.
+    HeapObject* Pop();
+
+    bool is_main_thread() const { return is_main_thread_; }
+
+   private:
+    ParallelMarking* marking_;
+    bool is_main_thread_;
+    Segment* current_;
+    Segment* bailouts_;
+    List<Object**> recorded_slots_;
+
+    DISALLOW_COPY_AND_ASSIGN(Local);
+  };
+
+  ParallelMarking(MarkCompactCollector* collector, int number_of_tasks);
+  ~ParallelMarking();
+
+  // Called by a background task before it starts marking. Returns false if
+  // marking has already terminated, in which case the task must not touch
+  // the heap anymore.
+  bool EnterTask();
+
+  // Blocks until all background tasks that were posted have finished and
+  // returns the slots they recorded.
+  List<Object**>* WaitForTasks();
+
+  int tasks_posted() const { return tasks_posted_; }
+
+ private:
+  void Publish(Segment* segment);
+  void PublishBailouts(Segment* segment);
+  void PublishRecordedSlots(List<Object**>* slots);
+  Segment* Steal(bool is_main_thread);
+
+  void PostTasks();
+
+  MarkCompactCollector* collector_;
+  int number_of_tasks_;
+  int tasks_posted_;
+
+  // The following fields are protected by mutex_.
+  base::Mutex mutex_;
+  base::ConditionVariable work_available_;
+  Segment* pool_;
+  Segment* bailouts_;
+  List<Object**> recorded_slots_;
+  int active_participants_;
+  int idle_participants_;
+  bool done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarking);
+};
+
+
 // Defined in isolate.h.
 class ThreadLocalTop;
 
@@ -624,6 +760,10 @@ class MarkCompactCollector {
 
   bool is_compacting() const { return compacting_; }
 
+  // True while a marking deque is drained by ParallelMarking. Mark bits and
+  // live bytes must then be updated atomically.
+  bool is_marking_in_parallel() const { return main_thread_marking_ != NULL; }
+
   MarkingParity marking_parity() { return marking_parity_; }
 
   // Concurrent and parallel sweeping support. If required_freed_bytes was set
@@ -633,21 +773,18 @@ class MarkCompactCollector {
   // continuous freed memory chunk.
   int SweepInParallel(PagedSpace* space, int required_freed_bytes);
 
-  // Sweeps a given page concurrently to the sweeper threads. It returns the
+  // Sweeps a given page concurrently to the sweeper tasks. It returns the
   // size of the maximum continuous freed memory chunk.
   int SweepInParallel(Page* page, PagedSpace* space);
 
   void EnsureSweepingCompleted();
 
-  // If sweeper threads are not active this method will return true. If
-  // this is a latency issue we should be smarter here. Otherwise, it will
-  // return true if the sweeper threads are done processing the pages.
+  // Returns true if all sweeper tasks posted since the last call to
+  // EnsureSweepingCompleted are done processing their pages.
   bool IsSweepingCompleted();
 
   void RefillFreeList(PagedSpace* space);
 
-  bool AreSweeperThreadsActivated();
-
   // Checks if sweeping is in progress right now on any space.
   bool sweeping_in_progress() { return sweeping_in_progress_; }
 
@@ -666,6 +803,7 @@ class MarkCompactCollector {
   void MarkAllocationSite(AllocationSite* site);
 
  private:
+  class MarkingTask;
   class SweeperTask;
 
   explicit MarkCompactCollector(Heap* heap);
@@ -676,7 +814,9 @@ class MarkCompactCollector {
   void RemoveDeadInvalidatedCode();
   void ProcessInvalidatedCode(ObjectVisitor* visitor);
 
-  void StartSweeperThreads();
+  // Posts a task that sweeps the pending pages of the given space on a
+  // background thread of the embedder's platform.
+  void StartSweeperTask(PagedSpace* space);
 
 #ifdef DEBUG
   enum CollectorState {
@@ -712,8 +852,18 @@ class MarkCompactCollector {
   // True if concurrent or parallel sweeping is currently in progress.
   bool sweeping_in_progress_;
 
+  // The number of sweeper tasks that have been posted and not yet waited for.
+  int pending_sweeper_jobs_;
   base::Semaphore pending_sweeper_jobs_semaphore_;
 
+  // True if the marking deque is drained in parallel during this GC.
+  bool use_parallel_marking_;
+
+  // The main thread's marking stack while marking runs in parallel.
+  ParallelMarking::Local* main_thread_marking_;
+
+  base::Semaphore pending_marking_tasks_semaphore_;
+
   bool sequential_sweeping_;
 
   SlotsBufferAllocator slots_buffer_allocator_;
@@ -732,6 +882,8 @@ class MarkCompactCollector {
   //
   //   After: Live objects are marked and non-live objects are unmarked.
 
+  friend class ParallelMarking;
+  friend class ParallelMarkingVisitor;
   friend class RootMarkingVisitor;
   friend class MarkingVisitor;
   friend class MarkCompactMarkingVisitor;
@@ -757,6 +909,10 @@ class MarkCompactCollector {
   // This is for non-incremental marking only.
   INLINE(void SetMark(HeapObject* obj, MarkBit mark_bit));
 
+  // Marks the object black with an atomic update of its mark bit. Returns
+  // false if another marking thread marked the object first.
+  INLINE(static bool SetMarkAtomically(HeapObject* obj, MarkBit mark_bit));
+
   // Mark the heap roots and all objects reachable from them.
   void MarkRoots(RootMarkingVisitor* visitor);
 
@@ -791,6 +947,14 @@ class MarkCompactCollector {
   // overflow flag will be set.
   void EmptyMarkingDeque();
 
+  // Parallel version of EmptyMarkingDeque, see ParallelMarking. It never
+  // overflows the marking stack.
+  void EmptyMarkingDequeInParallel();
+
+  // The number of background tasks used for parallel marking, not counting
+  // the main thread.
+  int NumberOfParallelMarkingTasks();
+
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
@@ -898,6 +1062,7 @@ class MarkCompactCollector {
 
   SmartPointer<FreeList> free_list_old_data_space_;
   SmartPointer<FreeList> free_list_old_pointer_space_;
+  SmartPointer<FreeList> free_list_map_space_;
 
   friend class Heap;
 };
@@ -131,7 +131,7 @@ bool CodeRange::SetUp(size_t requested) {
   Address base = reinterpret_cast<Address>(code_range_->address());
   Address aligned_base =
       RoundUp(reinterpret_cast<Address>(code_range_->address()),
-              MemoryChunk::kAlignment);
+              MemoryAllocator::ChunkAlignment(requested));
   size_t size = code_range_->size() - (aligned_base - base);
   allocation_list_.Add(FreeBlock(aligned_base, size));
   current_allocation_block_index_ = 0;
@@ -291,11 +291,29 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                          executable == EXECUTABLE)) {
     return false;
   }
+  AdviseHugePages(base, size);
   UpdateAllocatedSpaceLimits(base, base + size);
   return true;
 }
 
 
+size_t MemoryAllocator::ChunkAlignment(size_t chunk_size) {
+  if (FLAG_transparent_huge_pages && chunk_size >= kHugePageSize) {
+    return Max(kHugePageSize, static_cast<size_t>(MemoryChunk::kAlignment));
+  }
+  return MemoryChunk::kAlignment;
+}
+
+
+void MemoryAllocator::AdviseHugePages(Address start, size_t size) {
+  if (!FLAG_transparent_huge_pages) return;
+  // Advise the whole region even if it does not span an aligned huge page
+  // itself: adjacent chunks with the same advice are merged into a single
+  // mapping which the kernel can then collapse into huge pages.
+  base::OS::AdviseHugePages(start, size);
+}
+
+
 void MemoryAllocator::FreeMemory(base::VirtualMemory* reservation,
                                  Executability executable) {
   // TODO(gc) make code_range part of memory allocator?
@@ -374,6 +392,7 @@ Address MemoryAllocator::AllocateAlignedMemory(
     }
   } else {
     if (reservation.Commit(base, commit_size, false)) {
+      AdviseHugePages(base, commit_size);
       UpdateAllocatedSpaceLimits(base, base + commit_size);
     } else {
       base = NULL;
@@ -620,7 +639,7 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
       size_executable_ += chunk_size;
     } else {
       base = AllocateAlignedMemory(chunk_size, commit_size,
-                                   MemoryChunk::kAlignment, executable,
+                                   ChunkAlignment(chunk_size), executable,
                                    &reservation);
       if (base == NULL) return NULL;
       // Update executable memory size.
@@ -640,9 +659,9 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
     size_t commit_size =
         RoundUp(MemoryChunk::kObjectStartOffset + commit_area_size,
                 base::OS::CommitPageSize());
-    base =
-        AllocateAlignedMemory(chunk_size, commit_size, MemoryChunk::kAlignment,
-                              executable, &reservation);
+    base = AllocateAlignedMemory(chunk_size, commit_size,
+                                 ChunkAlignment(chunk_size), executable,
+                                 &reservation);
 
     if (base == NULL) return NULL;
 
@@ -854,6 +873,8 @@ bool MemoryAllocator::CommitExecutableMemory(base::VirtualMemory* vm,
                   commit_size - CodePageGuardStartOffset(), true)) {
     return false;
   }
+  AdviseHugePages(start + CodePageAreaStartOffset(),
+                  commit_size - CodePageGuardStartOffset());
 
   // Create guard page before the end.
   if (!vm->Guard(start + reserved_size - CodePageGuardSize())) {
@@ -2033,26 +2054,43 @@ void FreeListNode::set_next(FreeListNode* next) {
 }
 
 
-intptr_t FreeListCategory::Concatenate(FreeListCategory* category) {
-  intptr_t free_bytes = 0;
-  if (category->top() != NULL) {
-    // This is safe (not going to deadlock) since Concatenate operations
-    // are never performed on the same free lists at the same time in
-    // reverse order.
-    base::LockGuard<base::Mutex> target_lock_guard(mutex());
-    base::LockGuard<base::Mutex> source_lock_guard(category->mutex());
-    DCHECK(category->end_ != NULL);
-    free_bytes = category->available();
-    if (end_ == NULL) {
-      end_ = category->end();
-    } else {
-      category->end()->set_next(top());
-    }
-    set_top(category->top());
-    base::NoBarrier_Store(&top_, category->top_);
-    available_ += category->available();
-    category->Reset();
-  }
+void FreeListCategory::AddConcurrently(FreeListCategory* category) {
+  FreeListNode* top = category->top();
+  if (top == NULL) return;
+  DCHECK(category->end_ != NULL);
+  FreeListNode* end = category->end();
+  // Push the whole chain at once. The release store publishes the contents
+  // of the nodes to the thread that takes them.
+  base::AtomicWord old_top;
+  do {
+    old_top = base::NoBarrier_Load(&top_);
+    end->set_next(reinterpret_cast<FreeListNode*>(old_top));
+  } while (base::Release_CompareAndSwap(
+               &top_, old_top, reinterpret_cast<base::AtomicWord>(top)) !=
+           old_top);
+  category->Reset();
+}
+
+
+intptr_t FreeListCategory::TakeConcurrentlyAdded(FreeListCategory* category) {
+  base::AtomicWord taken;
+  do {
+    taken = base::Acquire_Load(&category->top_);
+    if (taken == 0) return 0;
+  } while (base::Acquire_CompareAndSwap(&category->top_, taken, 0) != taken);
+
+  // The shared category does not know the end and the size of the chain.
+  FreeListNode* top = reinterpret_cast<FreeListNode*>(taken);
+  FreeListNode* end = top;
+  intptr_t free_bytes = reinterpret_cast<FreeSpace*>(top)->Size();
+  for (FreeListNode* n = top->next(); n != NULL; n = n->next()) {
+    free_bytes += reinterpret_cast<FreeSpace*>(n)->Size();
+    end = n;
+  }
+  end->set_next(this->top());
+  if (end_ == NULL) end_ = end;
+  set_top(top);
+  available_ += static_cast<int>(free_bytes);
   return free_bytes;
 }
 
@@ -2164,12 +2202,20 @@ FreeList::FreeList(PagedSpace* owner) : owner_(owner), heap_(owner->heap()) {
 }
 
 
-intptr_t FreeList::Concatenate(FreeList* free_list) {
+void FreeList::AddConcurrently(FreeList* free_list) {
+  small_list_.AddConcurrently(free_list->small_list());
+  medium_list_.AddConcurrently(free_list->medium_list());
+  large_list_.AddConcurrently(free_list->large_list());
+  huge_list_.AddConcurrently(free_list->huge_list());
+}
+
+
+intptr_t FreeList::TakeConcurrentlyAdded(FreeList* free_list) {
   intptr_t free_bytes = 0;
-  free_bytes += small_list_.Concatenate(free_list->small_list());
-  free_bytes += medium_list_.Concatenate(free_list->medium_list());
-  free_bytes += large_list_.Concatenate(free_list->large_list());
-  free_bytes += huge_list_.Concatenate(free_list->huge_list());
+  free_bytes += small_list_.TakeConcurrentlyAdded(free_list->small_list());
+  free_bytes += medium_list_.TakeConcurrentlyAdded(free_list->medium_list());
+  free_bytes += large_list_.TakeConcurrentlyAdded(free_list->large_list());
+  free_bytes += huge_list_.TakeConcurrentlyAdded(free_list->huge_list());
   return free_bytes;
 }
 
@@ -7,7 +7,6 @@
 
 #include "src/allocation.h"
 #include "src/base/atomicops.h"
-#include "src/base/platform/mutex.h"
 #include "src/hashmap.h"
 #include "src/list.h"
 #include "src/log.h"
@@ -117,6 +116,22 @@ class MarkBit {
   inline bool Get() { return (*cell_ & mask_) != 0; }
   inline void Clear() { *cell_ &= ~mask_; }
 
+  // Sets the bit with a compare-and-swap on the whole cell, so that bits set
+  // concurrently by other marking threads are not lost. Returns false if the
+  // bit was already set.
+  inline bool SetAtomic() {
+    volatile base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    const base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value = base::NoBarrier_Load(cell);
+    while ((old_value & mask) == 0) {
+      base::Atomic32 actual =
+          base::NoBarrier_CompareAndSwap(cell, old_value, old_value | mask);
+      if (actual == old_value) return true;
+      old_value = actual;
+    }
+    return false;
+  }
+
   inline bool data_only() { return data_only_; }
 
   inline MarkBit Next() {
@@ -520,6 +535,14 @@ class MemoryChunk {
     MemoryChunk::FromAddress(address)->IncrementLiveBytes(by);
   }
 
+  // Used by parallel marking, where several threads account live bytes on
+  // the same chunk.
+  static void IncrementLiveBytesFromParallelGC(Address address, int by) {
+    MemoryChunk* chunk = MemoryChunk::FromAddress(address);
+    base::NoBarrier_AtomicIncrement(
+        reinterpret_cast<base::Atomic32*>(&chunk->live_byte_count_), by);
+  }
+
   static void IncrementLiveBytesFromMutator(Address address, int by);
 
   static const intptr_t kAlignment =
@@ -1059,6 +1082,14 @@ class MemoryAllocator {
                              intptr_t commit_area_size,
                              Executability executable, Space* space);
 
+  // Size of a transparent huge page. Chunks at least this large are aligned
+  // to it when --transparent-huge-pages is on so that the kernel can back
+  // them with huge pages.
+  static const size_t kHugePageSize = 2 * MB;
+
+  // Returns the alignment used for reserving a chunk of the given size.
+  static size_t ChunkAlignment(size_t chunk_size);
+
   Address ReserveAlignedMemory(size_t requested, size_t alignment,
                                base::VirtualMemory* controller);
   Address AllocateAlignedMemory(size_t reserve_size, size_t commit_size,
@@ -1153,6 +1184,10 @@ class MemoryAllocator {
   Page* InitializePagesInChunk(int chunk_id, int pages_in_chunk,
                                PagedSpace* owner);
 
+  // Advises the OS to back freshly committed memory with huge pages when
+  // --transparent-huge-pages is on.
+  void AdviseHugePages(Address start, size_t size);
+
   void UpdateAllocatedSpaceLimits(void* low, void* high) {
     lowest_ever_allocated_ = Min(lowest_ever_allocated_, low);
     highest_ever_allocated_ = Max(highest_ever_allocated_, high);
@@ -1443,7 +1478,16 @@ class FreeListCategory {
  public:
   FreeListCategory() : top_(0), end_(NULL), available_(0) {}
 
-  intptr_t Concatenate(FreeListCategory* category);
+  // Sweeper tasks hand the memory they free over to the main thread through
+  // a shared category, without taking a lock. Any number of threads may add
+  // the nodes of their private categories to the shared category, while a
+  // single thread takes all of them out of it. Only top_ is maintained for a
+  // shared category.
+  void AddConcurrently(FreeListCategory* category);
+
+  // Moves all nodes that were added concurrently to the given shared
+  // category to this category and returns their total size in bytes.
+  intptr_t TakeConcurrentlyAdded(FreeListCategory* category);
 
   void Reset();
 
@@ -1473,8 +1517,6 @@ class FreeListCategory {
   int available() const { return available_; }
   void set_available(int available) { available_ = available; }
 
-  base::Mutex* mutex() { return &mutex_; }
-
   bool IsEmpty() { return top() == 0; }
 
 #ifdef DEBUG
@@ -1486,7 +1528,6 @@ class FreeListCategory {
   // top_ points to the top FreeListNode* in the free list category.
   base::AtomicWord top_;
   FreeListNode* end_;
-  base::Mutex mutex_;
 
   // Total available bytes in all blocks of this free list category.
   int available_;
@@ -1520,7 +1561,11 @@ class FreeList {
  public:
   explicit FreeList(PagedSpace* owner);
 
-  intptr_t Concatenate(FreeList* free_list);
+  // See FreeListCategory::AddConcurrently.
+  void AddConcurrently(FreeList* free_list);
+
+  // See FreeListCategory::TakeConcurrentlyAdded.
+  intptr_t TakeConcurrentlyAdded(FreeList* free_list);
 
   // Clear the free list.
   void Reset();
@@ -1915,9 +1960,9 @@ class PagedSpace : public Space {
   // sweeping is done conservatively.
   intptr_t unswept_free_bytes_;
 
-  // The sweeper threads iterate over the list of pointer and data space pages
-  // and sweep these pages concurrently. They will stop sweeping after the
-  // end_of_unswept_pages_ page.
+  // The sweeper tasks iterate over the list of pointer, data and map space
+  // pages and sweep these pages concurrently. They will stop sweeping after
+  // the end_of_unswept_pages_ page.
   Page* end_of_unswept_pages_;
 
   // Emergency memory is the memory of a full page for a given space, allocated
@@ -367,27 +367,34 @@ void StoreBuffer::GCEpilogue() {
 }
 
 
+void StoreBuffer::FindPointerToNewSpace(Object** slot,
+                                        ObjectSlotCallback slot_callback,
+                                        bool clear_maps) {
+  Object* object = reinterpret_cast<Object*>(
+      base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+  if (heap_->InNewSpace(object)) {
+    HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
+    DCHECK(heap_object->IsHeapObject());
+    // The new space object was not promoted if it still contains a map
+    // pointer. Clear the map field now lazily.
+    if (clear_maps) ClearDeadObject(heap_object);
+    slot_callback(reinterpret_cast<HeapObject**>(slot), heap_object);
+    object = reinterpret_cast<Object*>(
+        base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
+    if (heap_->InNewSpace(object)) {
+      EnterDirectlyIntoStoreBuffer(reinterpret_cast<Address>(slot));
+    }
+  }
+}
+
+
 void StoreBuffer::FindPointersToNewSpaceInRegion(
     Address start, Address end, ObjectSlotCallback slot_callback,
     bool clear_maps) {
   for (Address slot_address = start; slot_address < end;
        slot_address += kPointerSize) {
-    Object** slot = reinterpret_cast<Object**>(slot_address);
-    Object* object = reinterpret_cast<Object*>(
-        base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
-    if (heap_->InNewSpace(object)) {
-      HeapObject* heap_object = reinterpret_cast<HeapObject*>(object);
-      DCHECK(heap_object->IsHeapObject());
-      // The new space object was not promoted if it still contains a map
-      // pointer. Clear the map field now lazily.
-      if (clear_maps) ClearDeadObject(heap_object);
-      slot_callback(reinterpret_cast<HeapObject**>(slot), heap_object);
-      object = reinterpret_cast<Object*>(
-          base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(slot)));
-      if (heap_->InNewSpace(object)) {
-        EnterDirectlyIntoStoreBuffer(slot_address);
-      }
-    }
+    FindPointerToNewSpace(reinterpret_cast<Object**>(slot_address),
+                          slot_callback, clear_maps);
   }
 }
 
@@ -434,6 +441,99 @@ void StoreBuffer::IteratePointersToNewSpaceAndClearMaps(
 }
 
 
+void StoreBuffer::PrepareScanOnScavengePage(MemoryChunk* chunk) {
+  if (chunk->owner() != heap_->old_pointer_space() &&
+      chunk->owner() != heap_->map_space()) {
+    return;
+  }
+  Page* page = reinterpret_cast<Page*>(chunk);
+  PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
+  if (!page->SweepingCompleted()) {
+    heap_->mark_compact_collector()->SweepInParallel(page, owner);
+    if (!page->SweepingCompleted()) {
+      // We were not able to sweep that page, i.e., a concurrent
+      // sweeper task currently owns this page.
+      // TODO(hpayer): This may introduce a huge pause here. We
+      // just care about finish sweeping of the scan on scavenge page.
+      heap_->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+  }
+}
+
+
+template <class RegionVisitor>
+void StoreBuffer::VisitRegionsOnScanOnScavengePage(MemoryChunk* chunk,
+                                                   RegionVisitor* visitor) {
+  if (chunk->owner() == heap_->lo_space()) {
+    LargePage* large_page = reinterpret_cast<LargePage*>(chunk);
+    HeapObject* array = large_page->GetObject();
+    DCHECK(array->IsFixedArray());
+    Address start = array->address();
+    Address end = start + array->Size();
+    visitor->VisitRegion(start, end);
+  } else {
+    Page* page = reinterpret_cast<Page*>(chunk);
+    PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
+    Address start = page->area_start();
+    Address end = page->area_end();
+    if (owner == heap_->map_space()) {
+      DCHECK(page->SweepingCompleted());
+      HeapObjectIterator iterator(page, NULL);
+      for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
+           heap_object = iterator.Next()) {
+        // We skip free space objects.
+        if (!heap_object->IsFiller()) {
+          DCHECK(heap_object->IsMap());
+          visitor->VisitRegion(
+              heap_object->address() + Map::kPointerFieldsBeginOffset,
+              heap_object->address() + Map::kPointerFieldsEndOffset);
+        }
+      }
+    } else {
+      DCHECK(page->SweepingCompleted());
+      // TODO(hpayer): remove the special casing and merge map and pointer
+      // space handling as soon as we removed conservative sweeping.
+      CHECK(page->owner() == heap_->old_pointer_space());
+      if (heap_->old_pointer_space()->swept_precisely()) {
+        HeapObjectIterator iterator(page, NULL);
+        for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
+             heap_object = iterator.Next()) {
+          // We iterate over objects that contain new space pointers only.
+          if (heap_object->MayContainNewSpacePointers()) {
+            visitor->VisitRegion(
+                heap_object->address() + HeapObject::kHeaderSize,
+                heap_object->address() + heap_object->Size());
+          }
+        }
+      } else {
+        visitor->VisitRegion(start, end);
+      }
+    }
+  }
+}
+
+
+// Processes the slots in the regions of a page one by one.
+class StoreBuffer::RegionProcessor {
+ public:
+  RegionProcessor(StoreBuffer* store_buffer, ObjectSlotCallback slot_callback,
+                  bool clear_maps)
+      : store_buffer_(store_buffer),
+        slot_callback_(slot_callback),
+        clear_maps_(clear_maps) {}
+
+  void VisitRegion(Address start, Address end) {
+    store_buffer_->FindPointersToNewSpaceInRegion(start, end, slot_callback_,
+                                                  clear_maps_);
+  }
+
+ private:
+  StoreBuffer* store_buffer_;
+  ObjectSlotCallback slot_callback_;
+  bool clear_maps_;
+};
+
+
 void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
                                             bool clear_maps) {
   // We do not sort or remove duplicated entries from the store buffer because
@@ -461,69 +561,25 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
     }
     PointerChunkIterator it(heap_);
     MemoryChunk* chunk;
-    while ((chunk = it.next()) != NULL) {
-      if (chunk->scan_on_scavenge()) {
-        chunk->set_scan_on_scavenge(false);
-        if (callback_ != NULL) {
-          (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
+    if (FLAG_parallel_store_buffer_scanning && !clear_maps) {
+      List<MemoryChunk*> pages;
+      while ((chunk = it.next()) != NULL) {
+        if (chunk->scan_on_scavenge()) {
+          PrepareScanOnScavengePage(chunk);
+          pages.Add(chunk);
         }
-        if (chunk->owner() == heap_->lo_space()) {
-          LargePage* large_page = reinterpret_cast<LargePage*>(chunk);
-          HeapObject* array = large_page->GetObject();
-          DCHECK(array->IsFixedArray());
-          Address start = array->address();
-          Address end = start + array->Size();
-          FindPointersToNewSpaceInRegion(start, end, slot_callback, clear_maps);
-        } else {
-          Page* page = reinterpret_cast<Page*>(chunk);
-          PagedSpace* owner = reinterpret_cast<PagedSpace*>(page->owner());
-          Address start = page->area_start();
-          Address end = page->area_end();
-          if (owner == heap_->map_space()) {
-            DCHECK(page->WasSweptPrecisely());
-            HeapObjectIterator iterator(page, NULL);
-            for (HeapObject* heap_object = iterator.Next(); heap_object != NULL;
-                 heap_object = iterator.Next()) {
-              // We skip free space objects.
-              if (!heap_object->IsFiller()) {
-                DCHECK(heap_object->IsMap());
-                FindPointersToNewSpaceInRegion(
-                    heap_object->address() + Map::kPointerFieldsBeginOffset,
-                    heap_object->address() + Map::kPointerFieldsEndOffset,
-                    slot_callback, clear_maps);
-              }
-            }
-          } else {
-            if (!page->SweepingCompleted()) {
-              heap_->mark_compact_collector()->SweepInParallel(page, owner);
-              if (!page->SweepingCompleted()) {
-                // We were not able to sweep that page, i.e., a concurrent
-                // sweeper thread currently owns this page.
-                // TODO(hpayer): This may introduce a huge pause here. We
-                // just care about finish sweeping of the scan on scavenge page.
-                heap_->mark_compact_collector()->EnsureSweepingCompleted();
-              }
-            }
-            // TODO(hpayer): remove the special casing and merge map and pointer
-            // space handling as soon as we removed conservative sweeping.
-            CHECK(page->owner() == heap_->old_pointer_space());
-            if (heap_->old_pointer_space()->swept_precisely()) {
-              HeapObjectIterator iterator(page, NULL);
-              for (HeapObject* heap_object = iterator.Next();
-                   heap_object != NULL; heap_object = iterator.Next()) {
-                // We iterate over objects that contain new space pointers only.
-                if (heap_object->MayContainNewSpacePointers()) {
-                  FindPointersToNewSpaceInRegion(
-                      heap_object->address() + HeapObject::kHeaderSize,
-                      heap_object->address() + heap_object->Size(),
-                      slot_callback, clear_maps);
-                }
-              }
-            } else {
-              FindPointersToNewSpaceInRegion(start, end, slot_callback,
-                                             clear_maps);
-            }
+      }
+      IteratePointersOnScanOnScavengePagesInParallel(&pages, slot_callback);
+    } else {
+      RegionProcessor processor(this, slot_callback, clear_maps);
+      while ((chunk = it.next()) != NULL) {
+        if (chunk->scan_on_scavenge()) {
+          chunk->set_scan_on_scavenge(false);
+          if (callback_ != NULL) {
+            (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
           }
+          PrepareScanOnScavengePage(chunk);
+          VisitRegionsOnScanOnScavengePage(chunk, &processor);
         }
       }
     }
@@ -534,6 +590,119 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
 }
 
 
+// Finds the slots that point to new space in a list of pages marked
+// scan_on_scavenge. Pages are claimed one at a time by the main thread and
+// the ScanPagesTasks. Scanning only reads the heap, so it is safe as long as
+// no objects are moved, which is guaranteed because the main thread waits for
+// all tasks before processing any of the slots.
+class StoreBuffer::PagesScanner {
+ public:
+  PagesScanner(StoreBuffer* store_buffer, List<MemoryChunk*>* pages)
+      : store_buffer_(store_buffer),
+        pages_(pages),
+        slots_(new List<Object**>[pages->length()]),
+        next_page_(0),
+        pending_tasks_semaphore_(0) {}
+
+  ~PagesScanner() { delete[] slots_; }
+
+  void ScanPages() {
+    while (true) {
+      int index = base::NoBarrier_AtomicIncrement(&next_page_, 1) - 1;
+      if (index >= pages_->length()) return;
+      SlotCollector collector(store_buffer_->heap_, &slots_[index]);
+      store_buffer_->VisitRegionsOnScanOnScavengePage(pages_->at(index),
+                                                      &collector);
+    }
+  }
+
+  List<Object**>* slots(int index) { return &slots_[index]; }
+
+  base::Semaphore* pending_tasks_semaphore() {
+    return &pending_tasks_semaphore_;
+  }
+
+ private:
+  class SlotCollector {
+   public:
+    SlotCollector(Heap* heap, List<Object**>* slots)
+        : heap_(heap), slots_(slots) {}
+
+    void VisitRegion(Address start, Address end) {
+      for (Address slot_address = start; slot_address < end;
+           slot_address += kPointerSize) {
+        Object** slot = reinterpret_cast<Object**>(slot_address);
+        if (heap_->InNewSpace(*slot)) slots_->Add(slot);
+      }
+    }
+
+   private:
+    Heap* heap_;
+    List<Object**>* slots_;
+  };
+
+  StoreBuffer* store_buffer_;
+  List<MemoryChunk*>* pages_;
+  List<Object**>* slots_;
+  base::Atomic32 next_page_;
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(PagesScanner);
+};
+
+
+class StoreBuffer::ScanPagesTask : public v8::Task {
+ public:
+  explicit ScanPagesTask(PagesScanner* scanner) : scanner_(scanner) {}
+
+  virtual ~ScanPagesTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    scanner_->ScanPages();
+    scanner_->pending_tasks_semaphore()->Signal();
+  }
+
+  PagesScanner* scanner_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScanPagesTask);
+};
+
+
+int StoreBuffer::NumberOfScanPagesTasks(int number_of_pages) {
+  int tasks = heap_->isolate()->max_available_threads() - 1;
+  return Max(Min(tasks, number_of_pages - 1), 0);
+}
+
+
+void StoreBuffer::IteratePointersOnScanOnScavengePagesInParallel(
+    List<MemoryChunk*>* pages, ObjectSlotCallback slot_callback) {
+  PagesScanner scanner(this, pages);
+  int number_of_tasks = NumberOfScanPagesTasks(pages->length());
+  for (int i = 0; i < number_of_tasks; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new ScanPagesTask(&scanner), v8::Platform::kShortRunningTask);
+  }
+  scanner.ScanPages();
+  for (int i = 0; i < number_of_tasks; i++) {
+    scanner.pending_tasks_semaphore()->Wait();
+  }
+
+  for (int i = 0; i < pages->length(); i++) {
+    MemoryChunk* chunk = pages->at(i);
+    chunk->set_scan_on_scavenge(false);
+    if (callback_ != NULL) {
+      (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
+    }
+    List<Object**>* slots = scanner.slots(i);
+    for (int j = 0; j < slots->length(); j++) {
+      FindPointerToNewSpace(slots->at(j), slot_callback, false);
+    }
+  }
+}
+
+
 void StoreBuffer::Compact() {
   Address* top = reinterpret_cast<Address*>(heap_->store_buffer_top());
 
@@ -154,6 +154,30 @@ class StoreBuffer {
                                       ObjectSlotCallback slot_callback,
                                       bool clear_maps);
 
+  inline void FindPointerToNewSpace(Object** slot,
+                                    ObjectSlotCallback slot_callback,
+                                    bool clear_maps);
+
+  // Makes sure a page marked scan_on_scavenge can be iterated.
+  void PrepareScanOnScavengePage(MemoryChunk* chunk);
+
+  class RegionProcessor;
+
+  // Calls visitor->VisitRegion(start, end) for every region of a page marked
+  // scan_on_scavenge that may contain pointers to new space.
+  template <class RegionVisitor>
+  void VisitRegionsOnScanOnScavengePage(MemoryChunk* chunk,
+                                        RegionVisitor* visitor);
+
+  // Pages marked scan_on_scavenge are searched for pointers to new space by
+  // the main thread and background tasks (--parallel-store-buffer-scanning).
+  // The slots that were found are processed on the main thread.
+  class ScanPagesTask;
+  class PagesScanner;
+  int NumberOfScanPagesTasks(int number_of_pages);
+  void IteratePointersOnScanOnScavengePagesInParallel(
+      List<MemoryChunk*>* pages, ObjectSlotCallback slot_callback);
+
   // For each region of pointers on a page in use from an old space call
   // visit_pointer_region callback.
   // If either visit_pointer_region or callback can cause an allocation
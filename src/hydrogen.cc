@@ -2574,14 +2574,17 @@ HValue* HGraphBuilder::BuildCalculateElementsSize(ElementsKind kind,
 }
 
 
-HAllocate* HGraphBuilder::AllocateJSArrayObject(AllocationSiteMode mode) {
+HAllocate* HGraphBuilder::AllocateJSArrayObject(AllocationSiteMode mode,
+                                                PretenureFlag pretenure_flag) {
   int base_size = JSArray::kSize;
   if (mode == TRACK_ALLOCATION_SITE) {
+    // Allocation mementos are only ever looked up behind new space objects.
+    DCHECK(pretenure_flag == NOT_TENURED);
     base_size += AllocationMemento::kSize;
   }
   HConstant* size_in_bytes = Add<HConstant>(base_size);
   return Add<HAllocate>(
-      size_in_bytes, HType::JSArray(), NOT_TENURED, JS_OBJECT_TYPE);
+      size_in_bytes, HType::JSArray(), pretenure_flag, JS_OBJECT_TYPE);
 }
 
 
@@ -2597,12 +2600,13 @@ HConstant* HGraphBuilder::EstablishElementsAllocationSize(
 
 
 HAllocate* HGraphBuilder::BuildAllocateElements(ElementsKind kind,
-                                                HValue* size_in_bytes) {
+                                                HValue* size_in_bytes,
+                                                PretenureFlag pretenure_flag) {
   InstanceType instance_type = IsFastDoubleElementsKind(kind)
       ? FIXED_DOUBLE_ARRAY_TYPE
       : FIXED_ARRAY_TYPE;
 
-  return Add<HAllocate>(size_in_bytes, HType::HeapObject(), NOT_TENURED,
+  return Add<HAllocate>(size_in_bytes, HType::HeapObject(), pretenure_flag,
                         instance_type);
 }
 
@@ -2924,8 +2928,9 @@ void HGraphBuilder::BuildCopyElements(HValue* from_elements,
 HValue* HGraphBuilder::BuildCloneShallowArrayCow(HValue* boilerplate,
                                                  HValue* allocation_site,
                                                  AllocationSiteMode mode,
+                                                 PretenureFlag pretenure_flag,
                                                  ElementsKind kind) {
-  HAllocate* array = AllocateJSArrayObject(mode);
+  HAllocate* array = AllocateJSArrayObject(mode, pretenure_flag);
 
   HValue* map = AddLoadMap(boilerplate);
   HValue* elements = AddLoadElements(boilerplate);
@@ -2942,10 +2947,12 @@ HValue* HGraphBuilder::BuildCloneShallowArrayCow(HValue* boilerplate,
 }
 
 
-HValue* HGraphBuilder::BuildCloneShallowArrayEmpty(HValue* boilerplate,
-                                                   HValue* allocation_site,
-                                                   AllocationSiteMode mode) {
-  HAllocate* array = AllocateJSArrayObject(mode);
+HValue* HGraphBuilder::BuildCloneShallowArrayEmpty(
+    HValue* boilerplate,
+    HValue* allocation_site,
+    AllocationSiteMode mode,
+    PretenureFlag pretenure_flag) {
+  HAllocate* array = AllocateJSArrayObject(mode, pretenure_flag);
 
   HValue* map = AddLoadMap(boilerplate);
 
@@ -2960,10 +2967,12 @@ HValue* HGraphBuilder::BuildCloneShallowArrayEmpty(HValue* boilerplate,
 }
 
 
-HValue* HGraphBuilder::BuildCloneShallowArrayNonEmpty(HValue* boilerplate,
-                                                      HValue* allocation_site,
-                                                      AllocationSiteMode mode,
-                                                      ElementsKind kind) {
+HValue* HGraphBuilder::BuildCloneShallowArrayNonEmpty(
+    HValue* boilerplate,
+    HValue* allocation_site,
+    AllocationSiteMode mode,
+    PretenureFlag pretenure_flag,
+    ElementsKind kind) {
   HValue* boilerplate_elements = AddLoadElements(boilerplate);
   HValue* capacity = AddLoadFixedArrayLength(boilerplate_elements);
 
@@ -2976,9 +2985,10 @@ HValue* HGraphBuilder::BuildCloneShallowArrayNonEmpty(HValue* boilerplate,
   // time the object will be fully prepared for GC if it happens during
   // elements allocation.
   HValue* result = BuildCloneShallowArrayEmpty(
-      boilerplate, allocation_site, mode);
+      boilerplate, allocation_site, mode, pretenure_flag);
 
-  HAllocate* elements = BuildAllocateElements(kind, elements_size);
+  HAllocate* elements =
+      BuildAllocateElements(kind, elements_size, pretenure_flag);
 
   // This function implicitly relies on the fact that the
   // FastCloneShallowArrayStub is called only for literals shorter than
@@ -1816,10 +1816,12 @@ class HGraphBuilder {
                                        HValue* length_argument);
   HValue* BuildCalculateElementsSize(ElementsKind kind,
                                      HValue* capacity);
-  HAllocate* AllocateJSArrayObject(AllocationSiteMode mode);
+  HAllocate* AllocateJSArrayObject(AllocationSiteMode mode,
+                                   PretenureFlag pretenure_flag = NOT_TENURED);
   HConstant* EstablishElementsAllocationSize(ElementsKind kind, int capacity);
 
-  HAllocate* BuildAllocateElements(ElementsKind kind, HValue* size_in_bytes);
+  HAllocate* BuildAllocateElements(ElementsKind kind, HValue* size_in_bytes,
+                                   PretenureFlag pretenure_flag = NOT_TENURED);
 
   void BuildInitializeElementsHeader(HValue* elements,
                                      ElementsKind kind,
@@ -1868,15 +1870,18 @@ class HGraphBuilder {
   HValue* BuildCloneShallowArrayCow(HValue* boilerplate,
                                     HValue* allocation_site,
                                     AllocationSiteMode mode,
+                                    PretenureFlag pretenure_flag,
                                     ElementsKind kind);
 
   HValue* BuildCloneShallowArrayEmpty(HValue* boilerplate,
                                       HValue* allocation_site,
-                                      AllocationSiteMode mode);
+                                      AllocationSiteMode mode,
+                                      PretenureFlag pretenure_flag);
 
   HValue* BuildCloneShallowArrayNonEmpty(HValue* boilerplate,
                                          HValue* allocation_site,
                                          AllocationSiteMode mode,
+                                         PretenureFlag pretenure_flag,
                                          ElementsKind kind);
 
   HValue* BuildElementIndexHash(HValue* index);
@@ -5509,6 +5509,12 @@ class Code: public HeapObject {
   inline bool is_compiled_optimizable();
   inline void set_compiled_optimizable(bool value);
 
+  // [has_reloc_info_for_serialization]: For FUNCTION kind, tells if its
+  // reloc info includes runtime and external references to support
+  // serialization/deserialization.
+  inline bool has_reloc_info_for_serialization();
+  inline void set_has_reloc_info_for_serialization(bool value);
+
   // [allow_osr_at_loop_nesting_level]: For FUNCTION kind, tells for
   // how long the function has been marked for OSR and therefore which
   // level of loop nesting we are willing to do on-stack replacement
@@ -5785,6 +5791,8 @@ class Code: public HeapObject {
       public BitField<bool, 0, 1> {};  // NOLINT
   class FullCodeFlagsHasDebugBreakSlotsField: public BitField<bool, 1, 1> {};
   class FullCodeFlagsIsCompiledOptimizable: public BitField<bool, 2, 1> {};
+  class FullCodeFlagsHasRelocInfoForSerialization
+      : public BitField<bool, 3, 1> {};  // NOLINT
 
   static const int kProfilerTicksOffset = kFullCodeFlags + 1;
 
@@ -6877,6 +6885,11 @@ class Script: public Struct {
   // the 'flags' field.
   DECL_BOOLEAN_ACCESSORS(is_shared_cross_origin)
 
+  // [compiled_for_serialization]: Whether the script was compiled to produce
+  // a code cache. Functions of such a script are lazily compiled with code
+  // that can be serialized as well. Encoded in the 'flags' field.
+  DECL_BOOLEAN_ACCESSORS(compiled_for_serialization)
+
   DECLARE_CAST(Script)
 
   // If script source is an external string, check that the underlying
@@ -6929,6 +6942,7 @@ class Script: public Struct {
   static const int kCompilationTypeBit = 0;
   static const int kCompilationStateBit = 1;
   static const int kIsSharedCrossOriginBit = 2;
+  static const int kCompiledForSerializationBit = 3;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Script);
 };
@@ -346,17 +346,17 @@ class ParserTraits::Checkpoint
  public:
   explicit Checkpoint(ParserBase<ParserTraits>* parser)
       : CheckpointBase(parser) {
-    isolate_ = parser->zone()->isolate();
-    saved_ast_node_id_ = isolate_->ast_node_id();
+    zone_ = parser->zone();
+    saved_ast_node_id_ = zone_->ast_node_id();
   }
 
   void Restore() {
     CheckpointBase::Restore();
-    isolate_->set_ast_node_id(saved_ast_node_id_);
+    zone_->set_ast_node_id(saved_ast_node_id_);
   }
 
  private:
-  Isolate* isolate_;
+  Zone* zone_;
   int saved_ast_node_id_;
 };
 
@@ -731,13 +731,12 @@ FunctionLiteral* ParserTraits::ParseFunctionLiteral(
 }
 
 
-Parser::Parser(CompilationInfo* info)
-    : ParserBase<ParserTraits>(&scanner_,
-                               info->isolate()->stack_guard()->real_climit(),
+Parser::Parser(CompilationInfo* info, const ParseInfo* parse_info)
+    : ParserBase<ParserTraits>(&scanner_, parse_info->stack_limit,
                                info->extension(), NULL, info->zone(), this),
       isolate_(info->isolate()),
       script_(info->script()),
-      scanner_(isolate_->unicode_cache()),
+      scanner_(parse_info->unicode_cache),
       reusable_preparser_(NULL),
       original_scope_(NULL),
       target_stack_(NULL),
@@ -747,9 +746,12 @@ Parser::Parser(CompilationInfo* info)
       has_pending_error_(false),
       pending_error_message_(NULL),
       pending_error_arg_(NULL),
-      pending_error_char_arg_(NULL) {
-  DCHECK(!script_.is_null());
-  isolate_->set_ast_node_id(0);
+      pending_error_char_arg_(NULL),
+      total_preparse_skipped_(0),
+      hash_seed_(parse_info->hash_seed),
+      pre_parse_timer_(NULL) {
+  DCHECK(!script_.is_null() || info->source_stream() != NULL);
+  info->zone()->set_ast_node_id(0);
   set_allow_harmony_scoping(!info->is_native() && FLAG_harmony_scoping);
   set_allow_modules(!info->is_native() && FLAG_harmony_modules);
   set_allow_natives_syntax(FLAG_allow_natives_syntax || info->is_native());
@@ -788,6 +790,7 @@ FunctionLiteral* Parser::ParseProgram() {
 
   source = String::Flatten(source);
   FunctionLiteral* result;
+  Scope* top_scope = NULL;
   if (source->IsExternalTwoByteString()) {
     // Notice that the stream is destroyed at the end of the branch block.
     // The last line of the blocks can't be moved outside, even though they're
@@ -795,11 +798,22 @@ FunctionLiteral* Parser::ParseProgram() {
     ExternalTwoByteStringUtf16CharacterStream stream(
         Handle<ExternalTwoByteString>::cast(source), 0, source->length());
     scanner_.Initialize(&stream);
-    result = DoParseProgram(info(), source);
+    result = DoParseProgram(info(), &top_scope);
   } else {
     GenericStringUtf16CharacterStream stream(source, 0, source->length());
     scanner_.Initialize(&stream);
-    result = DoParseProgram(info(), source);
+    result = DoParseProgram(info(), &top_scope);
+  }
+  top_scope->set_end_position(source->length());
+  HandleSourceURLComments();
+
+  ast_value_factory_->Internalize(isolate());
+  if (result == NULL) {
+    if (stack_overflow()) {
+      isolate()->StackOverflow();
+    } else {
+      ThrowPendingError();
+    }
   }
 
   if (FLAG_trace_parse && result != NULL) {
@@ -824,7 +838,7 @@ FunctionLiteral* Parser::ParseProgram() {
 
 
 FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
-                                        Handle<String> source) {
+                                        Scope** program_scope) {
   DCHECK(scope_ == NULL);
   DCHECK(target_stack_ == NULL);
 
@@ -848,7 +862,7 @@ FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
       scope = NewScope(scope, GLOBAL_SCOPE);
     }
     scope->set_start_position(0);
-    scope->set_end_position(source->length());
+    *program_scope = scope;
 
     // Compute the parsing mode.
     Mode mode = (FLAG_lazy && allow_lazy()) ? PARSE_LAZILY : PARSE_EAGERLY;
@@ -869,8 +883,6 @@ FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
     int beg_pos = scanner()->location().beg_pos;
     ParseSourceElements(body, Token::EOS, info->is_eval(), true, &ok);
 
-    HandleSourceURLComments();
-
     if (ok && strict_mode() == STRICT) {
       CheckOctalLiteral(beg_pos, scanner()->location().end_pos, &ok);
     }
@@ -889,7 +901,6 @@ FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
       }
     }
 
-    ast_value_factory_->Internalize(isolate());
     if (ok) {
       result = factory()->NewFunctionLiteral(
           ast_value_factory_->empty_string(), ast_value_factory_, scope_, body,
@@ -903,10 +914,6 @@ FunctionLiteral* Parser::DoParseProgram(CompilationInfo* info,
       result->set_ast_properties(factory()->visitor()->ast_properties());
       result->set_dont_optimize_reason(
           factory()->visitor()->dont_optimize_reason());
-    } else if (stack_overflow()) {
-      isolate()->StackOverflow();
-    } else {
-      ThrowPendingError();
     }
   }
 
@@ -3647,8 +3654,7 @@ void Parser::SkipLazyFunctionBody(const AstRawString* function_name,
     if (!*ok) {
       return;
     }
-    isolate()->counters()->total_preparse_skipped()->Increment(
-        scope_->end_position() - function_block_pos);
+    total_preparse_skipped_ += scope_->end_position() - function_block_pos;
     *materialized_literal_count = entry.literal_count();
     *expected_property_count = entry.property_count();
     scope_->SetStrictMode(entry.strict_mode());
@@ -3676,8 +3682,7 @@ void Parser::SkipLazyFunctionBody(const AstRawString* function_name,
     if (!*ok) {
       return;
     }
-    isolate()->counters()->total_preparse_skipped()->Increment(
-        scope_->end_position() - function_block_pos);
+    total_preparse_skipped_ += scope_->end_position() - function_block_pos;
     *materialized_literal_count = logger.literals();
     *expected_property_count = logger.properties();
     scope_->SetStrictMode(logger.strict_mode());
@@ -3755,12 +3760,15 @@ ZoneList<Statement*>* Parser::ParseEagerFunctionBody(
 
 PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     SingletonLogger* logger) {
-  HistogramTimerScope preparse_scope(isolate()->counters()->pre_parse());
+  // This function may be called on a background thread too; record only
+  // main thread preparse times.
+  if (pre_parse_timer_ != NULL) {
+    pre_parse_timer_->Start();
+  }
   DCHECK_EQ(Token::LBRACE, scanner()->current_token());
 
   if (reusable_preparser_ == NULL) {
-    intptr_t stack_limit = isolate()->stack_guard()->real_climit();
-    reusable_preparser_ = new PreParser(&scanner_, NULL, stack_limit);
+    reusable_preparser_ = new PreParser(&scanner_, NULL, stack_limit());
     reusable_preparser_->set_allow_harmony_scoping(allow_harmony_scoping());
     reusable_preparser_->set_allow_modules(allow_modules());
     reusable_preparser_->set_allow_natives_syntax(allow_natives_syntax());
@@ -3775,6 +3783,9 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
       reusable_preparser_->PreParseLazyFunction(strict_mode(),
                                                 is_generator(),
                                                 logger);
+  if (pre_parse_timer_ != NULL) {
+    pre_parse_timer_->Stop();
+  }
   return result;
 }
 
@@ -3795,7 +3806,11 @@ Expression* Parser::ParseV8Intrinsic(bool* ok) {
     scope_->DeclarationScope()->ForceEagerCompilation();
   }
 
-  const Runtime::Function* function = Runtime::FunctionForName(name->string());
+  // Intrinsic function names are one-byte strings.
+  const Runtime::Function* function =
+      name->is_one_byte()
+          ? Runtime::FunctionForName(name->raw_data(), name->length())
+          : NULL;
 
   // Check for built-in IS_VAR macro.
   if (function != NULL &&
@@ -3963,6 +3978,9 @@ void Parser::InternalizeUseCounts() {
       isolate()->CountUsage(v8::Isolate::UseCounterFeature(feature));
     }
   }
+  isolate()->counters()->total_preparse_skipped()->Increment(
+      total_preparse_skipped_);
+  total_preparse_skipped_ = 0;
 }
 
 
@@ -4800,15 +4818,17 @@ bool RegExpParser::ParseRegExp(FlatStringReader* input,
 bool Parser::Parse() {
   DCHECK(info()->function() == NULL);
   FunctionLiteral* result = NULL;
+  pre_parse_timer_ = isolate()->counters()->pre_parse();
   ast_value_factory_ = info()->ast_value_factory();
   if (ast_value_factory_ == NULL) {
     ast_value_factory_ =
-        new AstValueFactory(zone(), isolate()->heap()->HashSeed());
+        new AstValueFactory(zone(), hash_seed_);
   }
-  if (allow_natives_syntax() || extension_ != NULL) {
-    // If intrinsics are allowed, the Parser cannot operate independent of the
-    // V8 heap because of Rumtime. Tell the string table to internalize strings
-    // and values right after they're created.
+  if (extension_ != NULL) {
+    // If there is an extension, the Parser cannot operate independent of the
+    // V8 heap because native function declarations are looked up in it. Tell
+    // the string table to internalize strings and values right after they're
+    // created.
     ast_value_factory_->Internalize(isolate());
   }
 
@@ -4836,4 +4856,76 @@ bool Parser::Parse() {
   return (result != NULL);
 }
 
+
+
+void Parser::ParseOnBackground() {
+  DCHECK(info()->function() == NULL);
+  FunctionLiteral* result = NULL;
+  ast_value_factory_ = info()->ast_value_factory();
+  if (ast_value_factory_ == NULL) {
+    ast_value_factory_ = new AstValueFactory(zone(), hash_seed_);
+  }
+  fni_ = new(zone()) FuncNameInferrer(ast_value_factory_, zone());
+
+  CompleteParserRecorder recorder;
+  if (compile_options() == ScriptCompiler::kProduceParserCache) {
+    log_ = &recorder;
+  }
+
+  DCHECK(info()->source_stream() != NULL);
+  ExternalStreamingStream stream(info()->source_stream(),
+                                 info()->source_stream_encoding());
+  scanner_.Initialize(&stream);
+  DCHECK(info()->context().is_null() || info()->context()->IsNativeContext());
+
+  // When streaming, we don't know the length of the source until we have
+  // parsed it. The raw data can be UTF-8, so we wouldn't know the source
+  // length even if it was available anyway. The end position of the program
+  // scope is the position of the end token.
+  Scope* top_scope = NULL;
+  result = DoParseProgram(info(), &top_scope);
+  if (top_scope != NULL) {
+    top_scope->set_end_position(scanner()->peek_location().end_pos);
+  }
+
+  info()->SetFunction(result);
+
+  // We cannot internalize on a background thread; a foreground task will
+  // take care of calling Parser::Internalize just before compilation.
+
+  if (compile_options() == ScriptCompiler::kProduceParserCache) {
+    if (result != NULL) *info_->cached_data() = recorder.GetScriptData();
+    log_ = NULL;
+  }
+
+  // info takes ownership of ast_value_factory_.
+  if (info()->ast_value_factory() == NULL) {
+    info()->SetAstValueFactory(ast_value_factory_);
+  }
+  ast_value_factory_ = NULL;
+}
+
+
+void Parser::Internalize() {
+  DCHECK(!info()->script().is_null());
+  script_ = info()->script();
+  ast_value_factory_ = info()->ast_value_factory();
+  ast_value_factory_->Internalize(isolate());
+
+  // Internalize the source URL comments now that we have a script object.
+  HandleSourceURLComments();
+
+  if (info()->function() == NULL) {
+    if (stack_overflow()) {
+      isolate()->StackOverflow();
+    } else {
+      ThrowPendingError();
+    }
+  }
+
+  // Move statistics to Isolate.
+  InternalizeUseCounts();
+  ast_value_factory_ = NULL;
+}
+
 } }  // namespace v8::internal
@@ -380,15 +380,14 @@ class ParserTraits {
   // Custom operations executed when FunctionStates are created and destructed.
   template<typename FunctionState>
   static void SetUpFunctionState(FunctionState* function_state, Zone* zone) {
-    Isolate* isolate = zone->isolate();
-    function_state->saved_ast_node_id_ = isolate->ast_node_id();
-    isolate->set_ast_node_id(BailoutId::FirstUsable().ToInt());
+    function_state->saved_ast_node_id_ = zone->ast_node_id();
+    zone->set_ast_node_id(BailoutId::FirstUsable().ToInt());
   }
 
   template<typename FunctionState>
   static void TearDownFunctionState(FunctionState* function_state, Zone* zone) {
     if (function_state->outer_function_state_ != NULL) {
-      zone->isolate()->set_ast_node_id(function_state->saved_ast_node_id_);
+      zone->set_ast_node_id(function_state->saved_ast_node_id_);
     }
   }
 
@@ -596,7 +595,16 @@ class ParserTraits {
 
 class Parser : public ParserBase<ParserTraits> {
  public:
-  explicit Parser(CompilationInfo* info);
+  // Note that the hash seed in ParseInfo must be the hash seed from the
+  // Isolate's heap, otherwise the heap will be in an inconsistent state once
+  // the strings created by the Parser are internalized.
+  struct ParseInfo {
+    uintptr_t stack_limit;
+    uint32_t hash_seed;
+    UnicodeCache* unicode_cache;
+  };
+
+  Parser(CompilationInfo* info, const ParseInfo* parse_info);
   ~Parser() {
     delete reusable_preparser_;
     reusable_preparser_ = NULL;
@@ -609,12 +617,25 @@ class Parser : public ParserBase<ParserTraits> {
   // nodes) if parsing failed.
   static bool Parse(CompilationInfo* info,
                     bool allow_lazy = false) {
-    Parser parser(info);
+    ParseInfo parse_info = {info->isolate()->stack_guard()->real_climit(),
+                            info->isolate()->heap()->HashSeed(),
+                            info->isolate()->unicode_cache()};
+    Parser parser(info, &parse_info);
     parser.set_allow_lazy(allow_lazy);
     return parser.Parse();
   }
   bool Parse();
 
+  // Parses the streamed source of the compilation info. Can be called on a
+  // background thread; it doesn't touch the heap. The result must be
+  // finalized with Internalize on the main thread.
+  void ParseOnBackground();
+
+  // Handles the heap-dependent parts of a background parse: internalizes the
+  // strings, records the source URL comments and throws any pending error.
+  // Called on the main thread once the script object exists.
+  void Internalize();
+
  private:
   friend class ParserTraits;
 
@@ -649,9 +670,10 @@ class Parser : public ParserBase<ParserTraits> {
   Isolate* isolate() { return isolate_; }
   CompilationInfo* info() const { return info_; }
 
-  // Called by ParseProgram after setting up the scanner.
-  FunctionLiteral* DoParseProgram(CompilationInfo* info,
-                                  Handle<String> source);
+  // Called by ParseProgram and ParseOnBackground after setting up the
+  // scanner. Returns the scope of the program in {scope}, so that the caller
+  // can set its end position.
+  FunctionLiteral* DoParseProgram(CompilationInfo* info, Scope** scope);
 
   void SetCachedData();
 
@@ -819,6 +841,9 @@ class Parser : public ParserBase<ParserTraits> {
   bool pending_error_is_reference_error_;
 
   int use_counts_[v8::Isolate::kUseCounterFeatureCount];
+  int total_preparse_skipped_;
+  uint32_t hash_seed_;
+  HistogramTimer* pre_parse_timer_;
 };
 
 
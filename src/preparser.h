@@ -99,6 +99,8 @@ class ParserBase : public Traits {
   }
   bool allow_classes() const { return scanner()->HarmonyClasses(); }
 
+  uintptr_t stack_limit() const { return stack_limit_; }
+
   // Setters that determine whether certain syntactical constructs are
   // allowed to be parsed by this instance of the parser.
   void set_allow_lazy(bool allow) { allow_lazy_ = allow; }
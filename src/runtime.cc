@@ -12,6 +12,7 @@
 #include "src/api.h"
 #include "src/arguments.h"
 #include "src/base/cpu.h"
+#include "src/base/lazy-instance.h"
 #include "src/base/platform/platform.h"
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
@@ -15616,6 +15617,59 @@ const Runtime::Function* Runtime::FunctionForName(Handle<String> name) {
 }
 
 
+// A table of the intrinsic functions keyed by their names, for looking them
+// up without access to the heap (e.g. when parsing on a background thread).
+class IntrinsicFunctionTable {
+ public:
+  // Longer than the name of any intrinsic function, including the '_' of
+  // inline functions.
+  static const int kMaxNameLength = 64;
+
+  IntrinsicFunctionTable() : map_(&NameMatch) {
+    for (int i = 0; i < Runtime::kNumFunctions; ++i) {
+      const char* name = kIntrinsicFunctions[i].name;
+      if (name == NULL) continue;
+      int length = StrLength(name);
+      DCHECK(length < kMaxNameLength);
+      HashMap::Entry* entry =
+          map_.Lookup(const_cast<char*>(name), Hash(name, length), true);
+      entry->value = const_cast<Runtime::Function*>(&kIntrinsicFunctions[i]);
+    }
+  }
+
+  const Runtime::Function* Lookup(const unsigned char* name, int length) {
+    if (length >= kMaxNameLength) return NULL;
+    char key[kMaxNameLength];
+    MemCopy(key, name, length);
+    key[length] = '\0';
+    HashMap::Entry* entry = map_.Lookup(key, Hash(key, length), false);
+    if (entry == NULL) return NULL;
+    return static_cast<const Runtime::Function*>(entry->value);
+  }
+
+ private:
+  static uint32_t Hash(const char* name, int length) {
+    return StringHasher::HashSequentialString(name, length, 0);
+  }
+
+  static bool NameMatch(void* key1, void* key2) {
+    return strcmp(static_cast<char*>(key1), static_cast<char*>(key2)) == 0;
+  }
+
+  HashMap map_;
+};
+
+
+static base::LazyInstance<IntrinsicFunctionTable>::type
+    intrinsic_function_table = LAZY_INSTANCE_INITIALIZER;
+
+
+const Runtime::Function* Runtime::FunctionForName(const unsigned char* name,
+                                                  int length) {
+  return intrinsic_function_table.Pointer()->Lookup(name, length);
+}
+
+
 const Runtime::Function* Runtime::FunctionForEntry(Address entry) {
   for (size_t i = 0; i < ARRAY_SIZE(kIntrinsicFunctions); ++i) {
     if (entry == kIntrinsicFunctions[i].entry) {
@@ -798,6 +798,11 @@ class Runtime : public AllStatic {
   // Get the intrinsic function with the given name, which must be internalized.
   static const Function* FunctionForName(Handle<String> name);
 
+  // Get the intrinsic function with the given one-byte name. Doesn't touch
+  // the heap, so it can be used while parsing on a background thread.
+  static const Function* FunctionForName(const unsigned char* name,
+                                         int length);
+
   // Get the intrinsic function with the given FunctionId.
   static const Function* FunctionForId(FunctionId id);
 
@@ -276,6 +276,172 @@ void Utf8ToUtf16CharacterStream::SetRawPosition(unsigned target_position) {
 }
 
 
+// ----------------------------------------------------------------------------
+// ExternalStreamingStream
+
+// Returns the number of bytes in the UTF-8 encoding of the character starting
+// with {first_byte}. Invalid first bytes are treated as one-byte characters.
+static unsigned Utf8SequenceLength(byte first_byte) {
+  if ((first_byte & 0xE0) == 0xC0) return 2;
+  if ((first_byte & 0xF0) == 0xE0) return 3;
+  if ((first_byte & 0xF8) == 0xF0) return 4;
+  return 1;
+}
+
+
+// Writes {c} as one or two UTF-16 code units and returns their number.
+static unsigned WriteUtf16(uc16* dest, unibrow::uchar c) {
+  static const unibrow::uchar kMaxUtf16Character = 0xffff;
+  if (c > kMaxUtf16Character) {
+    dest[0] = unibrow::Utf16::LeadSurrogate(c);
+    dest[1] = unibrow::Utf16::TrailSurrogate(c);
+    return 2;
+  }
+  dest[0] = static_cast<uc16>(c);
+  return 1;
+}
+
+
+unsigned ExternalStreamingStream::FillBuffer(unsigned position) {
+  // The position is ignored; the data is consumed strictly in order, and
+  // ExternalStreamingStream keeps track of the position in the raw data.
+  unsigned data_in_buffer = 0;
+  // Leave room for a surrogate pair at the end of the buffer, so that a
+  // character never needs to be split across two fills.
+  while (data_in_buffer < kBufferSize - 1) {
+    if (current_data_ == NULL) {
+      // This blocks until the embedder has more data.
+      FetchChunk();
+      bool data_ends = current_data_length_ == 0;
+      if (encoding_ == ScriptCompiler::StreamedSource::UTF8) {
+        data_in_buffer +=
+            HandleUtf8SplitCharacters(buffer_ + data_in_buffer, data_ends);
+      }
+      if (data_ends) {
+        DisposeChunk();
+        return data_in_buffer;
+      }
+      // Completing a split character may have filled the buffer. The rest of
+      // the chunk is then copied by the next fill.
+      if (data_in_buffer >= kBufferSize - 1) break;
+    }
+    data_in_buffer += CopyCharsFromChunk(buffer_ + data_in_buffer,
+                                         kBufferSize - data_in_buffer);
+    DCHECK(data_in_buffer <= kBufferSize);
+    if (current_data_offset_ == current_data_length_) DisposeChunk();
+  }
+  return data_in_buffer;
+}
+
+
+void ExternalStreamingStream::FetchChunk() {
+  DCHECK(current_data_ == NULL);
+  current_data_length_ =
+      static_cast<unsigned>(source_stream_->GetMoreData(&current_data_));
+  current_data_offset_ = 0;
+}
+
+
+void ExternalStreamingStream::DisposeChunk() {
+  delete[] current_data_;
+  current_data_ = NULL;
+  current_data_offset_ = 0;
+  current_data_length_ = 0;
+}
+
+
+unsigned ExternalStreamingStream::CopyCharsFromChunk(uc16* dest,
+                                                     unsigned length) {
+  const uint8_t* src = current_data_ + current_data_offset_;
+  unsigned src_length = current_data_length_ - current_data_offset_;
+  switch (encoding_) {
+    case ScriptCompiler::StreamedSource::ONE_BYTE: {
+      unsigned count = Min(length, src_length);
+      CopyChars(dest, src, count);
+      current_data_offset_ += count;
+      return count;
+    }
+    case ScriptCompiler::StreamedSource::TWO_BYTE: {
+      // The embedder is expected to split two-byte data at character
+      // boundaries.
+      unsigned count = Min(length, src_length / 2);
+      CopyChars(dest, reinterpret_cast<const uc16*>(src), count);
+      current_data_offset_ += count * 2;
+      if (count < length) current_data_offset_ = current_data_length_;
+      return count;
+    }
+    case ScriptCompiler::StreamedSource::UTF8: {
+      // Incomplete characters at the end of the chunk have already been
+      // moved out of it by HandleUtf8SplitCharacters.
+      // A character may need two code units, so stop one short of the end.
+      unsigned i = 0;
+      unsigned cursor = 0;
+      while (i + 1 < length && cursor < src_length) {
+        unibrow::uchar c = src[cursor];
+        if (c <= unibrow::Utf8::kMaxOneByteChar) {
+          cursor++;
+        } else {
+          unsigned char_length = 0;
+          c = unibrow::Utf8::CalculateValue(src + cursor, src_length - cursor,
+                                            &char_length);
+          cursor += char_length;
+        }
+        i += WriteUtf16(dest + i, c);
+      }
+      current_data_offset_ += cursor;
+      return i;
+    }
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+
+unsigned ExternalStreamingStream::HandleUtf8SplitCharacters(uc16* dest,
+                                                            bool data_ends) {
+  unsigned written = 0;
+  // First complete a character left over from the previous chunk(s).
+  if (utf8_split_char_buffer_length_ > 0) {
+    unsigned needed = Utf8SequenceLength(utf8_split_char_buffer_[0]);
+    while (utf8_split_char_buffer_length_ < needed &&
+           current_data_offset_ < current_data_length_ &&
+           (current_data_[current_data_offset_] & 0xC0) == 0x80) {
+      utf8_split_char_buffer_[utf8_split_char_buffer_length_++] =
+          current_data_[current_data_offset_++];
+    }
+    if (utf8_split_char_buffer_length_ < needed && !data_ends &&
+        current_data_offset_ == current_data_length_) {
+      // The character continues in the next chunk.
+      return 0;
+    }
+    unsigned char_length = 0;
+    unibrow::uchar c = unibrow::Utf8::CalculateValue(
+        utf8_split_char_buffer_, utf8_split_char_buffer_length_, &char_length);
+    written = WriteUtf16(dest, c);
+    utf8_split_char_buffer_length_ = 0;
+  }
+  // Then move an incomplete character at the end of this chunk aside, so
+  // that it can be decoded once the rest of its bytes arrive.
+  unsigned end = current_data_length_;
+  unsigned start = end;
+  while (start > current_data_offset_ && end - start < 4) {
+    byte b = current_data_[--start];
+    if ((b & 0xC0) != 0x80) {
+      if (b > unibrow::Utf8::kMaxOneByteChar &&
+          Utf8SequenceLength(b) > end - start) {
+        for (unsigned i = start; i < end; i++) {
+          utf8_split_char_buffer_[utf8_split_char_buffer_length_++] =
+              current_data_[i];
+        }
+        current_data_length_ = start;
+      }
+      break;
+    }
+  }
+  return written;
+}
+
+
 // ----------------------------------------------------------------------------
 // ExternalTwoByteStringUtf16CharacterStream
 
@@ -10,6 +10,7 @@
 #include "src/bootstrapper.h"
 #include "src/deoptimizer.h"
 #include "src/execution.h"
+#include "src/full-codegen.h"
 #include "src/global-handles.h"
 #include "src/ic-inl.h"
 #include "src/natives.h"
@@ -1394,6 +1395,30 @@ void StartupSerializer::SerializeWeakReferences() {
 }
 
 
+void WriteStartupBlob(const List<byte>& snapshot_data,
+                      const Serializer& serializer,
+                      const List<byte>& context_snapshot_data,
+                      const Serializer& context_serializer,
+                      SnapshotByteSink* sink) {
+  static const int kSpaces[] = {
+      NEW_SPACE, OLD_POINTER_SPACE, OLD_DATA_SPACE, CODE_SPACE,
+      MAP_SPACE, CELL_SPACE,        PROPERTY_CELL_SPACE
+  };
+
+  sink->PutBlob(snapshot_data.begin(), snapshot_data.length(), "snapshot");
+  for (size_t i = 0; i < ARRAY_SIZE(kSpaces); ++i) {
+    sink->PutInt(serializer.CurrentAllocationAddress(kSpaces[i]), "spaces");
+  }
+
+  sink->PutBlob(context_snapshot_data.begin(), context_snapshot_data.length(),
+                "context");
+  for (size_t i = 0; i < ARRAY_SIZE(kSpaces); ++i) {
+    sink->PutInt(context_serializer.CurrentAllocationAddress(kSpaces[i]),
+                 "spaces");
+  }
+}
+
+
 void Serializer::PutRoot(int root_index,
                          HeapObject* object,
                          SerializerDeserializer::HowToCode how_to_code,
@@ -1842,6 +1867,16 @@ void CodeSerializer::SerializeObject(Object* o, HowToCode how_to_code,
       SerializeBuiltin(code_object, how_to_code, where_to_point, skip);
       return;
     }
+    if (code_object->kind() == Code::FUNCTION &&
+        !code_object->has_reloc_info_for_serialization()) {
+      // Code compiled before the script was marked for serialization lacks
+      // the relocation information needed to deserialize it. The function is
+      // compiled lazily again instead.
+      Code* lazy =
+          isolate()->builtins()->builtin(Builtins::kCompileUnoptimized);
+      SerializeBuiltin(lazy, how_to_code, where_to_point, skip);
+      return;
+    }
     // TODO(yangguo) figure out whether other code kinds can be handled smarter.
   }
 
@@ -1900,12 +1935,43 @@ void CodeSerializer::SerializeSourceObject(HowToCode how_to_code,
 }
 
 
-Handle<SharedFunctionInfo> CodeSerializer::Deserialize(Isolate* isolate,
-                                                       ScriptData* data,
-                                                       Handle<String> source) {
+void CodeSerializer::ClearFeedbackForSerialization(Isolate* isolate,
+                                                   Handle<Script> script) {
+  // Creating the iterator may move the script with a full GC.
+  HeapIterator iterator(isolate->heap());
+  DisallowHeapAllocation no_gc;
+  Script* raw_script = *script;
+  for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    if (shared->script() != raw_script) continue;
+    if (!shared->optimized_code_map()->IsSmi()) {
+      shared->ClearOptimizedCodeMap();
+    }
+    shared->ClearTypeFeedbackInfo();
+    Code* code = shared->code();
+    if (code->kind() != Code::FUNCTION) continue;
+    code->ClearInlineCaches();
+    if (code->back_edges_patched_for_osr()) {
+      BackEdgeTable::Revert(isolate, code);
+    }
+    code->set_profiler_ticks(0);
+  }
+}
+
+
+MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
+    Isolate* isolate, ScriptData* data, Handle<String> source) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
-  SerializedCodeData scd(data, *source);
+  SerializedCodeData scd(data);
+  {
+    DisallowHeapAllocation no_gc;
+    if (!scd.IsSane(*source)) {
+      if (FLAG_profile_deserialization) PrintF("[Cached code rejected]\n");
+      return MaybeHandle<SharedFunctionInfo>();
+    }
+  }
   SnapshotByteSource payload(scd.Payload(), scd.PayloadLength());
   Deserializer deserializer(&payload);
   STATIC_ASSERT(NEW_SPACE == 0);
@@ -1940,8 +2006,14 @@ SerializedCodeData::SerializedCodeData(List<byte>* payload, CodeSerializer* cs)
             static_cast<size_t>(payload->length()));
   script_data_ = new ScriptData(data, data_length);
   script_data_->AcquireDataOwnership();
-  SetHeaderValue(kCheckSumOffset, CheckSum(cs->source()));
+  SetHeaderValue(kVersionHashOffset, Version::Hash());
+  SetHeaderValue(kSourceHashOffset, SourceHash(cs->source()));
+  SetHeaderValue(kFlagHashOffset, static_cast<int>(FlagList::Hash()));
+  SetHeaderValue(kPayloadLengthOffset, payload->length());
+  SetHeaderValue(kChecksumOffset, static_cast<int>(Checksum(
+                                      payload->begin(), payload->length())));
   STATIC_ASSERT(NEW_SPACE == 0);
+  STATIC_ASSERT(kReservationsOffset + PROPERTY_CELL_SPACE < kHeaderEntries);
   for (int i = NEW_SPACE; i <= PROPERTY_CELL_SPACE; i++) {
     SetHeaderValue(kReservationsOffset + i, cs->CurrentAllocationAddress(i));
   }
@@ -1949,17 +2021,54 @@ SerializedCodeData::SerializedCodeData(List<byte>* payload, CodeSerializer* cs)
 
 
 bool SerializedCodeData::IsSane(String* source) {
-  return GetHeaderValue(kCheckSumOffset) == CheckSum(source) &&
-         PayloadLength() >= SharedFunctionInfo::kSize;
+  if (script_data_->length() < kHeaderEntries * kIntSize) return false;
+  return GetHeaderValue(kVersionHashOffset) == Version::Hash() &&
+         GetHeaderValue(kSourceHashOffset) == SourceHash(source) &&
+         GetHeaderValue(kFlagHashOffset) ==
+             static_cast<int>(FlagList::Hash()) &&
+         GetHeaderValue(kPayloadLengthOffset) == PayloadLength() &&
+         PayloadLength() >= SharedFunctionInfo::kSize &&
+         GetHeaderValue(kChecksumOffset) ==
+             static_cast<int>(Checksum(Payload(), PayloadLength()));
+}
+
+
+// Adler-32 checksum of the payload.
+uint32_t SerializedCodeData::Checksum(const byte* payload, int length) {
+  static const uint32_t kModulus = 65521;
+  // Largest number of bytes that can be summed up before b overflows.
+  static const int kMaxChunk = 5552;
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (length > 0) {
+    int chunk = Min(length, kMaxChunk);
+    length -= chunk;
+    for (int i = 0; i < chunk; i++) {
+      a += payload[i];
+      b += a;
+    }
+    payload += chunk;
+    a %= kModulus;
+    b %= kModulus;
+  }
+  return (b << 16) | a;
 }
 
 
-int SerializedCodeData::CheckSum(String* string) {
-  int checksum = Version::Hash();
-#ifdef DEBUG
-  uint32_t seed = static_cast<uint32_t>(checksum);
-  checksum = static_cast<int>(IteratingStringHasher::Hash(string, seed));
-#endif  // DEBUG
-  return checksum;
+// Hashes all characters of the source. Unlike String::Hash() this neither
+// depends on the per-isolate hash seed nor stops at kMaxHashCalcLength.
+int SerializedCodeData::SourceHash(String* source) {
+  ConsStringIteratorOp op;
+  StringCharacterStream stream(source, &op);
+  uint32_t hash = static_cast<uint32_t>(source->length());
+  while (stream.HasMore()) {
+    hash += stream.GetNext();
+    hash += hash << 10;
+    hash ^= hash >> 6;
+  }
+  hash += hash << 3;
+  hash ^= hash >> 11;
+  hash += hash << 15;
+  return static_cast<int>(hash);
 }
 } }  // namespace v8::internal
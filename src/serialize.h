@@ -574,6 +574,16 @@ class StartupSerializer : public Serializer {
 };
 
 
+// Write the data of a startup snapshot and a context snapshot together with
+// the space reservations of their serializers, in the format of the external
+// startup blob (see snapshot-external.cc).
+void WriteStartupBlob(const List<byte>& snapshot_data,
+                      const Serializer& serializer,
+                      const List<byte>& context_snapshot_data,
+                      const Serializer& context_serializer,
+                      SnapshotByteSink* sink);
+
+
 class CodeSerializer : public Serializer {
  public:
   CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source)
@@ -589,9 +599,17 @@ class CodeSerializer : public Serializer {
   virtual void SerializeObject(Object* o, HowToCode how_to_code,
                                WhereToPoint where_to_point, int skip);
 
-  static Handle<SharedFunctionInfo> Deserialize(Isolate* isolate,
-                                                ScriptData* data,
-                                                Handle<String> source);
+  // Returns an empty handle if the data cannot be used for the source.
+  static MaybeHandle<SharedFunctionInfo> Deserialize(Isolate* isolate,
+                                                     ScriptData* data,
+                                                     Handle<String> source);
+
+  // Reset the code of all compiled functions of the script to its state
+  // right after compilation, so that it can be serialized after the script
+  // has run. Clears inline caches, type feedback, optimized code and OSR
+  // patches, all of which refer to context-specific objects.
+  static void ClearFeedbackForSerialization(Isolate* isolate,
+                                            Handle<Script> script);
 
   static const int kSourceObjectIndex = 0;
 
@@ -616,11 +634,8 @@ class CodeSerializer : public Serializer {
 class SerializedCodeData {
  public:
   // Used by when consuming.
-  explicit SerializedCodeData(ScriptData* data, String* source)
-      : script_data_(data), owns_script_data_(false) {
-    DisallowHeapAllocation no_gc;
-    CHECK(IsSane(source));
-  }
+  explicit SerializedCodeData(ScriptData* data)
+      : script_data_(data), owns_script_data_(false) {}
 
   // Used when producing.
   SerializedCodeData(List<byte>* payload, CodeSerializer* cs);
@@ -638,6 +653,10 @@ class SerializedCodeData {
     return result;
   }
 
+  // Check that the data was produced by this version of V8 with the same
+  // flags for the given source, and that it has not been corrupted.
+  bool IsSane(String* source);
+
   const byte* Payload() const {
     return script_data_->data() + kHeaderEntries * kIntSize;
   }
@@ -660,16 +679,24 @@ class SerializedCodeData {
     return reinterpret_cast<const int*>(script_data_->data())[offset];
   }
 
-  bool IsSane(String* source);
+  static int SourceHash(String* source);
 
-  int CheckSum(String* source);
+  static uint32_t Checksum(const byte* payload, int length);
 
   // The data header consists of int-sized entries:
   // [0] version hash
-  // [1..7] reservation sizes for spaces from NEW_SPACE to PROPERTY_CELL_SPACE.
-  static const int kCheckSumOffset = 0;
-  static const int kReservationsOffset = 1;
-  static const int kHeaderEntries = 8;
+  // [1] source hash (of the entire source, independent of the hash seed)
+  // [2] flag hash
+  // [3] payload length
+  // [4] payload checksum
+  // [5..11] reservation sizes for spaces from NEW_SPACE to PROPERTY_CELL_SPACE.
+  static const int kVersionHashOffset = 0;
+  static const int kSourceHashOffset = 1;
+  static const int kFlagHashOffset = 2;
+  static const int kPayloadLengthOffset = 3;
+  static const int kChecksumOffset = 4;
+  static const int kReservationsOffset = 5;
+  static const int kHeaderEntries = 12;
 
   ScriptData* script_data_;
   bool owns_script_data_;
@@ -50,7 +50,8 @@ Zone::Zone(Isolate* isolate)
       position_(0),
       limit_(0),
       segment_head_(NULL),
-      isolate_(isolate) {
+      isolate_(isolate),
+      ast_node_id_(0) {
 }
 
 
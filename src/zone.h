@@ -67,6 +67,11 @@ class Zone {
 
   inline Isolate* isolate() { return isolate_; }
 
+  // The next free AST node id. AST nodes are numbered per zone, so that
+  // parsing doesn't need to touch the isolate.
+  int ast_node_id() const { return ast_node_id_; }
+  void set_ast_node_id(int id) { ast_node_id_ = id; }
+
  private:
   friend class Isolate;
 
@@ -121,6 +126,7 @@ class Zone {
 
   Segment* segment_head_;
   Isolate* isolate_;
+  int ast_node_id_;
 };
 
 
@@ -659,3 +659,54 @@ TEST(OneTimeReduce1) {
   CHECK_EQ(&OPB1, end->op());
   CHECK_EQ(n1, end->InputAt(0));
 }
+
+
+// Reduces A0 => B0, A2 => B2 if its first input is B0, and A1 => B1 if its
+// input is B2, all in place.
+class ChainedABReducer : public Reducer {
+ public:
+  virtual Reduction Reduce(Node* node) {
+    switch (node->op()->opcode()) {
+      case OPCODE_A0:
+        node->set_op(&OPB0);
+        return Changed(node);
+      case OPCODE_A1:
+        if (node->InputAt(0)->op() != &OPB2) break;
+        node->set_op(&OPB1);
+        return Changed(node);
+      case OPCODE_A2:
+        if (node->InputAt(0)->op() != &OPB0) break;
+        node->set_op(&OPB2);
+        return Changed(node);
+    }
+    return NoChange();
+  }
+};
+
+
+TEST(ReduceLoopToFixpoint) {
+  GraphTester graph;
+
+  // Builds a cycle phi = A2(n1, use), use = A1(phi), where {use} can only be
+  // reduced after {phi}, which in turn is reduced after {use} was visited.
+  Node* n1 = graph.NewNode(&OPA0);
+  Node* phi = graph.NewNode(&OPA2, n1, n1);
+  Node* use = graph.NewNode(&OPA1, phi);
+  phi->ReplaceInput(1, use);
+  Node* end = graph.NewNode(&OPA1, phi);
+  graph.SetEnd(end);
+
+  GraphReducer reducer(&graph);
+  ChainedABReducer r;
+  reducer.AddReducer(&r);
+
+  // A single run should reach the fixpoint by revisiting {use}.
+  int before = graph.NodeCount();
+  reducer.ReduceGraph();
+  CHECK_EQ(before, graph.NodeCount());
+  CHECK_EQ(&OPB0, n1->op());
+  CHECK_EQ(&OPB2, phi->op());
+  CHECK_EQ(&OPB1, use->op());
+  CHECK_EQ(&OPB1, end->op());
+  CHECK_EQ(use, phi->InputAt(1));
+}
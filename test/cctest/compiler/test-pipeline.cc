@@ -38,3 +38,37 @@ TEST(PipelineAdd) {
   USE(pipeline);
 #endif
 }
+
+
+TEST(PipelineAddPhases) {
+  InitializedHandleScope handles;
+  const char* source = "(function(a,b) { return a + b; })";
+  Handle<JSFunction> function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(CompileRun(source)));
+  CompilationInfoWithZone info(function);
+
+  CHECK(Parser::Parse(&info));
+  StrictMode strict_mode = info.function()->strict_mode();
+  info.SetStrictMode(strict_mode);
+  CHECK(Rewriter::Rewrite(&info));
+  CHECK(Scope::Analyze(&info));
+  CHECK_NE(NULL, info.scope());
+
+  Pipeline pipeline(&info);
+#if V8_TURBOFAN_TARGET
+  CHECK(pipeline.CreateGraph());
+  {
+    // The middle phase must not touch the heap, as it does when running on
+    // the concurrent recompilation thread.
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+    CHECK(pipeline.OptimizeGraph());
+  }
+  Handle<Code> code = pipeline.AssembleCode();
+  CHECK(!code.is_null());
+  CHECK(info.code().is_identical_to(code));
+#else
+  USE(pipeline);
+#endif
+}
@@ -0,0 +1,109 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "test/cctest/compiler/function-tester.h"
+
+#if V8_TURBOFAN_TARGET
+
+using namespace v8::internal;
+using namespace v8::internal::compiler;
+
+// The functions below are called once before they are optimized, so that the
+// boilerplate of their object literal exists when the graph is built.
+
+TEST(EscapeAnalysisLoadAfterStore) {
+  FLAG_turbo_escape = true;
+  FunctionTester T(
+      "(function () {"
+      "  function f(a, b) {"
+      "    var o = { x: a, y: 1 };"
+      "    o.y = b;"
+      "    return o.x + o.y;"
+      "  };"
+      "  f(1, 2);"
+      "  return f;"
+      "})()");
+
+  T.CheckCall(T.Val(3), T.Val(1), T.Val(2));
+  T.CheckCall(T.Val(11), T.Val(4), T.Val(7));
+}
+
+
+TEST(EscapeAnalysisLoadAfterMerge) {
+  FLAG_turbo_escape = true;
+  FunctionTester T(
+      "(function () {"
+      "  function f(a, c) {"
+      "    var o = { x: 1, y: 2 };"
+      "    if (c) o.x = a;"
+      "    return o.x + o.y;"
+      "  };"
+      "  f(1, true);"
+      "  return f;"
+      "})()");
+
+  T.CheckCall(T.Val(7), T.Val(5), T.true_value());
+  T.CheckCall(T.Val(3), T.Val(5), T.false_value());
+}
+
+
+TEST(EscapeAnalysisEscapingObject) {
+  FLAG_turbo_escape = true;
+  FunctionTester T(
+      "(function () {"
+      "  function g(o) { return o.x; };"
+      "  function f(a) {"
+      "    var o = { x: 1 };"
+      "    o.x = a;"
+      "    return g(o) + o.x;"
+      "  };"
+      "  f(1);"
+      "  return f;"
+      "})()");
+
+  T.CheckCall(T.Val(6), T.Val(3));
+}
+
+
+TEST(EscapeAnalysisDeoptimize) {
+  FLAG_turbo_escape = true;
+  FLAG_turbo_deoptimization = true;
+  FunctionTester T(
+      "(function () {"
+      "  function f(a, deopt) {"
+      "    var o = { x: a, y: 2 };"
+      "    if (deopt) %DeoptimizeFunction(f);"
+      "    return o.x + o.y;"
+      "  };"
+      "  f(1, false);"
+      "  return f;"
+      "})()");
+
+  T.CheckCall(T.Val(3), T.Val(1), T.false_value());
+  T.CheckCall(T.Val(5), T.Val(3), T.true_value());
+}
+
+
+TEST(EscapeAnalysisDoubleField) {
+  FLAG_turbo_escape = true;
+  FLAG_turbo_deoptimization = true;
+  FunctionTester T(
+      "(function () {"
+      "  function f(a, deopt) {"
+      "    var o = { x: 1.5 };"
+      "    o.x = a;"
+      "    if (deopt) %DeoptimizeFunction(f);"
+      "    return o.x;"
+      "  };"
+      "  f(2.5, false);"
+      "  return f;"
+      "})()");
+
+  T.CheckCall(T.Val(0.5), T.Val(0.5), T.false_value());
+  T.CheckCall(T.Val("str"), T.Val("str"), T.true_value());
+}
+
+#endif  // V8_TURBOFAN_TARGET
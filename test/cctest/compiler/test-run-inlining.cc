@@ -181,4 +181,44 @@ TEST(InlineTwiceDependentDiamondReal) {
   T.CheckCall(T.Val(-11), T.Val(11), T.Val(4));
 }
 
+
+TEST(InlineRecursiveOnlyOnce) {
+  FLAG_turbo_inlining = true;
+  FunctionTester T(
+      "(function () {"
+      "function foo(s) { if (s <= 0) return 0; return foo(s - 1) + 2; };"
+      "function bar(s, t) { return foo(s); };"
+      "return bar;"
+      "})();");
+
+  T.CheckCall(T.Val(8), T.Val(4), T.undefined());
+}
+
+
+TEST(InlineGuardedByCallFeedback) {
+  FLAG_turbo_inlining = true;
+  FunctionTester T(
+      "var check_depth = false;"
+      "var foo = function(s) {"
+      "  if (check_depth) AssertStackDepth(1);"
+      "  return s + 1;"
+      "};"
+      "var baz = function(s) {"
+      "  if (check_depth) AssertStackDepth(2);"
+      "  return s * 2;"
+      "};"
+      "(function () {"
+      "function bar(o, s) { return o.f(s); };"
+      "bar({ f: foo }, 0);"
+      "return bar;"
+      "})();");
+
+  InstallAssertStackDepthHelper(CcTest::isolate());
+  CompileRun("check_depth = true;");
+  // The inlined body of foo runs in the frame of bar, while the generic call
+  // to baz gets a frame of its own.
+  T.CheckCall(T.Val(3), T.NewObject("({ f: foo })"), T.Val(2));
+  T.CheckCall(T.Val(4), T.NewObject("({ f: baz })"), T.Val(2));
+}
+
 #endif  // V8_TURBOFAN_TARGET
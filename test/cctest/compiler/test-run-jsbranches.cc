@@ -105,6 +105,27 @@ TEST(ForStatement) {
 }
 
 
+TEST(NestedForStatementWithSplitting) {
+  FLAG_turbo_splitting = true;
+  FLAG_turbo_splitting_min_instructions = 0;
+  FunctionTester T(
+      "(function(a,b) {"
+      "  var x = 0, y = 1, z = 2;"
+      "  for (var i = 0; i < a; i++) {"
+      "    for (var j = 0; j < b; j++) {"
+      "      x += i; y += j; z += x + y;"
+      "    }"
+      "  }"
+      "  return x + y + z;"
+      "})");
+
+  T.CheckCall(T.Val(3), T.Val(0.0), T.Val(0.0));
+  T.CheckCall(T.Val(13), T.Val(1), T.Val(3));
+  T.CheckCall(T.Val(193), T.Val(3), T.Val(4));
+  T.CheckCall(T.Val(133), T.Val(5), T.Val(2));
+}
+
+
 static void TestForIn(const char* code) {
   FunctionTester T(code);
   T.CheckCall(T.undefined(), T.undefined());
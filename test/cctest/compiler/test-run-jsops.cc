@@ -516,6 +516,75 @@ TEST(ArrayLiteral) {
 }
 
 
+TEST(ObjectLiteralShallowCopy) {
+  FunctionTester T(
+      "(function(a) {"
+      "  var r = [];"
+      "  for (var i = 0; i < 2; i++) r[i] = { x:'x', y:'y' };"
+      "  r[0].x = a;"
+      "  return r[1].x;"
+      "})");
+
+  T.CheckCall(T.Val("x"), T.Val("a"));
+  T.CheckCall(T.Val("x"), T.Val("b"));
+}
+
+
+TEST(ArrayLiteralShallowCopy) {
+  FunctionTester T(
+      "(function(a) {"
+      "  var r = [];"
+      "  for (var i = 0; i < 2; i++) r[i] = [1, 2, 3];"
+      "  r[0][1] = a;"
+      "  return r[1][1];"
+      "})");
+
+  T.CheckCall(T.Val(2), T.Val(5));
+  T.CheckCall(T.Val(2), T.Val("b"));
+}
+
+
+#if V8_TURBOFAN_TARGET
+
+// Creates the boilerplate of the first literal in the function, marks its
+// allocation site as tenured and recompiles the function with that feedback.
+static void RecompileWithTenuredFirstLiteral(FunctionTester* T) {
+  T->Call(T->undefined(), T->undefined()).ToHandleChecked();
+  Handle<AllocationSite> site(AllocationSite::cast(
+      T->function->literals()->get(JSFunction::kLiteralsPrefixSize)));
+  site->set_pretenure_decision(AllocationSite::kTenure);
+  T->function->ReplaceCode(T->function->shared()->code());
+  T->Compile(T->function);
+}
+
+
+TEST(ObjectLiteralPretenured) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  FunctionTester T("(function() { return { x:'x', y:'y' }; })");
+  RecompileWithTenuredFirstLiteral(&T);
+
+  Handle<Object> result =
+      T.Call(T.undefined(), T.undefined()).ToHandleChecked();
+  CHECK(result->IsJSObject());
+  CHECK(T.isolate->heap()->InOldPointerSpace(*result));
+}
+
+
+TEST(ArrayLiteralPretenured) {
+  if (!FLAG_allocation_site_pretenuring) return;
+  FunctionTester T("(function() { return ['x', 'y']; })");
+  RecompileWithTenuredFirstLiteral(&T);
+
+  Handle<Object> result =
+      T.Call(T.undefined(), T.undefined()).ToHandleChecked();
+  CHECK(result->IsJSArray());
+  CHECK(T.isolate->heap()->InOldPointerSpace(*result));
+  CHECK(!T.isolate->heap()->InNewSpace(JSArray::cast(*result)->elements()));
+}
+
+#endif  // V8_TURBOFAN_TARGET
+
+
 TEST(RegExpLiteral) {
   FunctionTester T("(function(a) { o = /b/; return o.test(a); })");
 
@@ -360,6 +360,82 @@ TEST(RPOLoopFollow1) {
 }
 
 
+TEST(RPOLoopFollowLoopTree) {
+  HandleAndZoneScope scope;
+  Schedule schedule(scope.main_zone());
+
+  SmartPointer<TestLoop> loop1(CreateLoop(&schedule, 2));
+  SmartPointer<TestLoop> loop2(CreateLoop(&schedule, 2));
+
+  BasicBlock* A = schedule.start();
+  BasicBlock* E = schedule.end();
+
+  schedule.AddSuccessor(A, loop1->header());
+  schedule.AddSuccessor(loop1->header(), loop2->header());
+  schedule.AddSuccessor(loop2->header(), E);
+
+  BasicBlockVector* order = Scheduler::ComputeSpecialRPO(&schedule);
+  CheckRPONumbers(order, 6, true);
+  CheckLoopContains(loop1->nodes, loop1->count);
+  CheckLoopContains(loop2->nodes, loop2->count);
+
+  // The second loop directly follows the first one in the RPO, but is not
+  // nested within it.
+  CHECK_EQ(NULL, loop1->header()->loop_header());
+  CHECK_EQ(NULL, loop2->header()->loop_header());
+  CHECK_EQ(loop1->header(), loop1->last()->loop_header());
+  CHECK_EQ(loop2->header(), loop2->last()->loop_header());
+  CHECK_EQ(1, loop1->header()->loop_depth_);
+  CHECK_EQ(1, loop2->header()->loop_depth_);
+  CHECK_EQ(0, E->loop_depth_);
+  CHECK_EQ(A, loop1->header()->LoopPreHeader());
+  CHECK_EQ(loop1->header(), loop2->header()->LoopPreHeader());
+
+  Schedule::BasicBlocks headers = schedule.loop_headers();
+  CHECK_EQ(2, static_cast<int>(headers.end() - headers.begin()));
+  CHECK_EQ(loop1->header(), *headers.begin());
+  CHECK_EQ(loop2->header(), *(headers.begin() + 1));
+}
+
+
+TEST(RPOLoopNestLoopTree) {
+  HandleAndZoneScope scope;
+  Schedule schedule(scope.main_zone());
+
+  BasicBlock* A = schedule.start();
+  BasicBlock* B = schedule.NewBasicBlock();
+  BasicBlock* C = schedule.NewBasicBlock();
+  BasicBlock* D = schedule.NewBasicBlock();
+  BasicBlock* E = schedule.NewBasicBlock();
+  BasicBlock* F = schedule.end();
+
+  schedule.AddSuccessor(A, B);
+  schedule.AddSuccessor(B, C);
+  schedule.AddSuccessor(C, D);
+  schedule.AddSuccessor(D, C);
+  schedule.AddSuccessor(D, E);
+  schedule.AddSuccessor(E, B);
+  schedule.AddSuccessor(E, F);
+
+  Scheduler::ComputeSpecialRPO(&schedule);
+
+  CHECK_EQ(NULL, B->loop_header());
+  CHECK_EQ(B, C->loop_header());
+  CHECK_EQ(C, D->loop_header());
+  CHECK_EQ(B, E->loop_header());
+  CHECK_EQ(1, B->loop_depth_);
+  CHECK_EQ(2, C->loop_depth_);
+  CHECK_EQ(2, D->loop_depth_);
+  CHECK_EQ(1, E->loop_depth_);
+  CHECK_EQ(0, F->loop_depth_);
+
+  Schedule::BasicBlocks headers = schedule.loop_headers();
+  CHECK_EQ(2, static_cast<int>(headers.end() - headers.begin()));
+  CHECK_EQ(B, *headers.begin());
+  CHECK_EQ(C, *(headers.begin() + 1));
+}
+
+
 TEST(RPOLoopFollow2) {
   HandleAndZoneScope scope;
   Schedule schedule(scope.main_zone());
@@ -1665,6 +1741,52 @@ TEST(BuildScheduleSimpleLoopWithCodeMotion) {
 }
 
 
+TEST(BuildScheduleHoistFromLoopHeader) {
+  HandleAndZoneScope scope;
+  Graph graph(scope.main_zone());
+  CommonOperatorBuilder common(scope.main_zone());
+  MachineOperatorBuilder machine(scope.main_zone());
+
+  // Manually built graph for:
+  // function turbo_fan_test(a, b) {
+  //   var i = a;
+  //   while (i < a + b) i = i + b;
+  //   return i;
+  // }
+  Node* start = graph.NewNode(common.Start(2));
+  graph.SetStart(start);
+  Node* p0 = graph.NewNode(common.Parameter(0), start);
+  Node* p1 = graph.NewNode(common.Parameter(1), start);
+  Node* loop = graph.NewNode(common.Loop(2), start, start);
+  Node* phi = graph.NewNode(common.Phi(2), p0, p0, loop);
+  Node* limit = graph.NewNode(machine.Int32Add(), p0, p1);
+  Node* cond = graph.NewNode(machine.Int32LessThan(), phi, limit);
+  Node* branch = graph.NewNode(common.Branch(), cond, loop);
+  Node* if_true = graph.NewNode(common.IfTrue(), branch);
+  Node* if_false = graph.NewNode(common.IfFalse(), branch);
+  Node* add = graph.NewNode(machine.Int32Add(), phi, p1);
+  loop->ReplaceInput(1, if_true);
+  phi->ReplaceInput(1, add);
+  Node* ret = graph.NewNode(common.Return(), phi, start, if_false);
+  graph.SetEnd(graph.NewNode(common.End(), ret));
+
+  PrintGraph(&graph);
+
+  Schedule* schedule = Scheduler::ComputeSchedule(&graph);
+
+  PrintSchedule(schedule);
+
+  // The loop bound is only used in the loop header, but it is loop-invariant
+  // and has to be hoisted into the pre-header.
+  BasicBlock* header = schedule->block(loop);
+  CHECK(header->IsLoopHeader());
+  CHECK_EQ(header, schedule->block(cond));
+  CHECK_EQ(header->LoopPreHeader(), schedule->block(limit));
+  CHECK_EQ(0, schedule->block(limit)->loop_depth_);
+  CHECK(header->LoopContains(schedule->block(add)));
+}
+
+
 #if V8_TURBOFAN_TARGET
 
 // So we can get a real JS function.
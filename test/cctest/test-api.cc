@@ -17777,6 +17777,31 @@ TEST(IdleNotificationWithLargeHint) {
 }
 
 
+// Test that the memory reducer collects garbage and shrinks the new space
+// when the embedder announces a long idle period.
+TEST(IdleForLongTimeNotification) {
+  const intptr_t MB = 1024 * 1024;
+  const int IdlePauseInMs = 1000;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  intptr_t initial_size = CcTest::heap()->SizeOfObjects();
+  CreateGarbageInOldSpace();
+  intptr_t size_with_garbage = CcTest::heap()->SizeOfObjects();
+  CHECK_GT(size_with_garbage, initial_size + MB);
+  env->GetIsolate()->IdleForLongTimeNotification();
+  bool finished = false;
+  for (int i = 0; i < 200 && !finished; i++) {
+    finished = env->GetIsolate()->IdleNotification(IdlePauseInMs);
+  }
+  intptr_t final_size = CcTest::heap()->SizeOfObjects();
+  CHECK(finished);
+  CHECK_LT(final_size, initial_size + 1);
+  CHECK_EQ(
+      static_cast<intptr_t>(CcTest::heap()->new_space()->InitialCapacity()),
+      CcTest::heap()->new_space()->Capacity());
+}
+
+
 TEST(Regress2107) {
   const intptr_t MB = 1024 * 1024;
   const int kShortIdlePauseInMs = 100;
@@ -22951,3 +22976,250 @@ TEST(GetOwnPropertyDescriptor) {
   set->Call(x, 1, args);
   CHECK_EQ(v8_num(14), get->Call(x, 0, NULL));
 }
+
+
+class TestSourceStream : public v8::ScriptCompiler::ExternalSourceStream {
+ public:
+  explicit TestSourceStream(const char** chunks) : chunks_(chunks), index_(0) {}
+
+  virtual size_t GetMoreData(const uint8_t** src) {
+    // Unlike in real use cases, this function will never block.
+    if (chunks_[index_] == NULL) {
+      return 0;
+    }
+    // Copy the data, since the caller takes ownership of it.
+    size_t len = strlen(chunks_[index_]);
+    uint8_t* copy = new uint8_t[len];
+    memcpy(copy, chunks_[index_], len);
+    *src = copy;
+    ++index_;
+    return len;
+  }
+
+  // Helper for constructing a string from chunks (the compilation needs it
+  // too).
+  static char* FullSourceString(const char** chunks) {
+    size_t total_len = 0;
+    for (size_t i = 0; chunks[i] != NULL; ++i) {
+      total_len += strlen(chunks[i]);
+    }
+    char* full_string = new char[total_len + 1];
+    size_t offset = 0;
+    for (size_t i = 0; chunks[i] != NULL; ++i) {
+      size_t len = strlen(chunks[i]);
+      memcpy(full_string + offset, chunks[i], len);
+      offset += len;
+    }
+    full_string[total_len] = 0;
+    return full_string;
+  }
+
+ private:
+  const char** chunks_;
+  unsigned index_;
+};
+
+
+// Helper thread for running script streaming tasks.
+class StreamerThread : public v8::base::Thread {
+ public:
+  explicit StreamerThread(v8::ScriptCompiler::ScriptStreamingTask* task)
+      : Thread(Options()), task_(task) {}
+
+  virtual void Run() { task_->Run(); }
+
+ private:
+  v8::ScriptCompiler::ScriptStreamingTask* task_;
+};
+
+
+// Streams {chunks} into V8 on a background thread and compiles the result.
+// Returns an empty handle if the script has errors.
+static v8::Local<v8::Script> CompileStreamed(
+    v8::Isolate* isolate, const char** chunks,
+    v8::ScriptCompiler::StreamedSource::Encoding encoding,
+    v8::ScriptCompiler::CompileOptions options =
+        v8::ScriptCompiler::kNoCompileOptions,
+    bool* has_cached_data = NULL) {
+  v8::ScriptCompiler::StreamedSource source(new TestSourceStream(chunks),
+                                            encoding);
+  v8::ScriptCompiler::ScriptStreamingTask* task =
+      v8::ScriptCompiler::StartStreamingScript(isolate, &source, options);
+  CHECK(task != NULL);
+
+  // Run the task on another thread, which checks that parsing doesn't need
+  // the isolate.
+  StreamerThread stream_thread(task);
+  stream_thread.Start();
+  stream_thread.Join();
+  delete task;
+
+  if (has_cached_data != NULL) {
+    *has_cached_data = source.GetCachedData() != NULL;
+  }
+
+  v8::ScriptOrigin origin(v8_str("http://foo.com"));
+  i::SmartArrayPointer<char> full_source(
+      TestSourceStream::FullSourceString(chunks));
+  return v8::ScriptCompiler::Compile(isolate, &source,
+                                     v8_str(full_source.get()), origin);
+}
+
+
+TEST(StreamingSimpleScript) {
+  // This script is unrealistically small, since no one chooses to stream such
+  // a small script. Since the math of the chunk sizes is done in the
+  // streaming code, we can test the chunking this way.
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  const char* chunks[] = {"function foo() { ret", "urn 13; } f", "oo(); ",
+                          NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingBiggerScript) {
+  // A function which is longer than the stream buffer, with inner functions
+  // which are parsed lazily.
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  const char* chunk1 =
+      "function foo() {\n"
+      "  // Make this chunk sufficiently long so that it will overflow the\n"
+      "  // backing buffer of the Scanner.\n"
+      "  var i = 0;\n"
+      "  var result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  result = 0;\n"
+      "  for (i = 0; i < 13; ++i) { result = result + 1; }\n"
+      "  function bar() { return result; }\n"
+      "  return bar();\n"
+      "}\n";
+  const char* chunks[] = {chunk1, "foo(); ", NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingScriptWithParseError) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  {
+    v8::TryCatch try_catch;
+    const char* chunks[] = {"function foo() { ret", "urn 13; } f", "oo(); ",
+                            "var x = ;", NULL};
+    v8::Local<v8::Script> script =
+        CompileStreamed(env->GetIsolate(), chunks,
+                        v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+    CHECK(script.IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+  // Streaming a script doesn't leave the parser in a bad state.
+  const char* chunks[] = {"function foo() { ret", "urn 13; } f", "oo(); ",
+                          NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingUtf8Script) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  // The chunks contain the Euro sign (U+20AC, encoded as E2 82 AC).
+  const char* chunks[] = {"function foo() { var foob\xe2\x82\xac", "r = 13; ",
+                          "return foob\xe2\x82\xacr; } foo(); ", NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::UTF8);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingUtf8ScriptWithSplitCharacters) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  // The Euro sign is split between the first two chunks, and the last one is
+  // split over three chunks.
+  const char* chunks[] = {"function foo() { var foob\xe2", "\x82\xacr = 13; ",
+                          "return foob\xe2", "\x82", "\xacr; } foo(); ",
+                          NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::UTF8);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingUtf8ScriptWithSplitCharacterAtBufferEnd) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  // The first chunk fills the scanner's 512 character buffer up to offset
+  // 510 and ends with the first half of U+1F600 (F0 9F 98 80). Completing
+  // it in the second chunk fills the buffer with a surrogate pair.
+  const char prefix[] = "var s = '";
+  const int kPadding = 510 - (sizeof(prefix) - 1);
+  char chunk1[512 + 1];
+  memcpy(chunk1, prefix, sizeof(prefix) - 1);
+  memset(chunk1 + sizeof(prefix) - 1, 'a', kPadding);
+  chunk1[510] = '\xf0';
+  chunk1[511] = '\x9f';
+  chunk1[512] = 0;
+  const char* chunks[] = {chunk1,
+                          "\x98\x80'; s.length == 503 && "
+                          "s.charCodeAt(501) == 0xd83d && "
+                          "s.charCodeAt(502) == 0xde00",
+                          NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::UTF8);
+  CHECK(!script.IsEmpty());
+  CHECK(script->Run()->IsTrue());
+}
+
+
+TEST(StreamingProducesParserCache) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  const char* chunks[] = {"function foo() { ret", "urn 13; } f", "oo(); ",
+                          NULL};
+  bool has_cached_data = false;
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::ONE_BYTE,
+      v8::ScriptCompiler::kProduceParserCache, &has_cached_data);
+  CHECK(!script.IsEmpty());
+  CHECK(has_cached_data);
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
+
+
+TEST(StreamingScriptWithNativesSyntax) {
+  // Intrinsic calls are resolved without the heap, so scripts using them
+  // can be parsed on the background thread too.
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  const char* chunks[] = {"function foo() { return %_Is", "Smi(13) ? 13 : 0; }",
+                          " foo();", NULL};
+  v8::Local<v8::Script> script = CompileStreamed(
+      env->GetIsolate(), chunks, v8::ScriptCompiler::StreamedSource::ONE_BYTE);
+  CHECK(!script.IsEmpty());
+  CHECK_EQ(13, script->Run()->Int32Value());
+}
@@ -1642,6 +1642,53 @@ TEST(TestSizeOfObjects) {
 }
 
 
+TEST(ConcurrentSweepingOfMapSpace) {
+  if (!i::FLAG_concurrent_sweeping) return;
+  i::FLAG_parallel_sweeping = false;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Create enough short-living maps to fill several map space pages.
+  CompileRun(
+      "for (var i = 0; i < 20000; i++) {"
+      "  var o = {};"
+      "  o['p' + i] = i;"
+      "}");
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+
+  // Only the first page of map space is swept during the GC pause. Heap
+  // verification completes sweeping right after the GC though.
+  if (collector->sweeping_in_progress()) {
+    int pages_swept_concurrently = 0;
+    PageIterator it(heap->map_space());
+    while (it.has_next()) {
+      if (!it.next()->WasSweptPrecisely()) pages_swept_concurrently++;
+    }
+    CHECK_GT(pages_swept_concurrently, 0);
+  }
+
+  // Allocating maps takes memory from the pages swept by the sweeper task.
+  v8::Local<v8::Value> result = CompileRun(
+      "var objects = [];"
+      "for (var i = 0; i < 1000; i++) {"
+      "  var o = {};"
+      "  o['q' + i] = i;"
+      "  objects.push(o);"
+      "}"
+      "objects[999].q999;");
+  CHECK_EQ(999, result->Int32Value());
+
+  if (collector->sweeping_in_progress()) {
+    collector->EnsureSweepingCompleted();
+  }
+  PageIterator swept_it(heap->map_space());
+  while (swept_it.has_next()) CHECK(swept_it.next()->WasSweptPrecisely());
+}
+
+
 TEST(TestSizeOfObjectsVsHeapIteratorPrecision) {
   CcTest::InitializeVM();
   HeapIterator iterator(CcTest::heap());
@@ -3800,6 +3847,45 @@ TEST(IncrementalMarkingStepMakesBigProgressWithLargeObjects) {
 }
 
 
+TEST(ParallelStoreBufferScanning) {
+  i::FLAG_parallel_store_buffer_scanning = true;
+  CcTest::InitializeVM();
+  // Make sure scanning tasks are posted even on single core machines.
+  CcTest::i_isolate()->set_max_available_threads(4);
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Spread old space arrays that point to new space over several pages and
+  // force the scavenger to scan those pages instead of using the store
+  // buffer.
+  const int kNumberOfArrays = 64;
+  const int kArrayLength = 4 * KB;
+  Handle<FixedArray> arrays[kNumberOfArrays];
+  for (int i = 0; i < kNumberOfArrays; i++) {
+    arrays[i] = factory->NewFixedArray(kArrayLength, TENURED);
+    CHECK(heap->InOldPointerSpace(*arrays[i]));
+    for (int j = 0; j < kArrayLength; j += 16) {
+      Handle<Object> number = factory->NewHeapNumber(i * kArrayLength + j);
+      CHECK(heap->InNewSpace(*number));
+      arrays[i]->set(j, *number);
+    }
+    MemoryChunk::FromAddress(arrays[i]->address())->set_scan_on_scavenge(true);
+  }
+
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+
+  for (int i = 0; i < kNumberOfArrays; i++) {
+    for (int j = 0; j < kArrayLength; j += 16) {
+      CHECK_EQ(i * kArrayLength + j,
+               static_cast<int>(arrays[i]->get(j)->Number()));
+    }
+  }
+}
+
+
 TEST(DisableInlineAllocation) {
   i::FLAG_allow_natives_syntax = true;
   CcTest::InitializeVM();
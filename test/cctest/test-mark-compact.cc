@@ -200,6 +200,103 @@ TEST(MarkCompactCollector) {
 }
 
 
+// Builds a graph that is large enough to be shared between the marking
+// tasks and that mixes objects the tasks can visit with objects that are
+// handed back to the main thread.
+static void CreateObjectGraph() {
+  CompileRun(
+      "var roots = [];"
+      "for (var i = 0; i < 200; i++) {"
+      "  var list = null;"
+      "  for (var j = 0; j < 100; j++) {"
+      "    list = { next: list, value: j, name: 'n' + j,"
+      "             array: [i, j], f: function() { return j; } };"
+      "  }"
+      "  roots.push(list);"
+      "}");
+}
+
+
+static void CheckObjectGraph() {
+  v8::Local<v8::Value> result = CompileRun(
+      "var sum = 0;"
+      "for (var i = 0; i < roots.length; i++) {"
+      "  for (var list = roots[i]; list != null; list = list.next) {"
+      "    sum += list.value + list.array[1] + list.name.length;"
+      "  }"
+      "}"
+      "sum;");
+  // Each list contributes 2 * (0 + ... + 99) plus the length of 10 names of
+  // length 2 and 90 names of length 3.
+  CHECK_EQ(200 * (2 * 4950 + 10 * 2 + 90 * 3), result->Int32Value());
+}
+
+
+TEST(ParallelMarking) {
+  FLAG_parallel_marking = true;
+  FLAG_incremental_marking = false;
+  FLAG_always_compact = true;
+  CcTest::InitializeVM();
+  // Make sure marking tasks are posted even on single core machines.
+  CcTest::i_isolate()->set_max_available_threads(4);
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CreateObjectGraph();
+  for (int i = 0; i < 3; i++) {
+    heap->CollectAllGarbage(Heap::kNoGCFlags, "test parallel marking");
+  }
+  CheckObjectGraph();
+}
+
+
+TEST(ParallelMarkingFinishesIncrementalMarking) {
+  FLAG_parallel_marking = true;
+  CcTest::InitializeVM();
+  CcTest::i_isolate()->set_max_available_threads(4);
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CreateObjectGraph();
+  IncrementalMarking* marking = heap->incremental_marking();
+  if (marking->IsStopped()) marking->Start();
+  // Leave most of the work on the incremental marking deque, which is handed
+  // over to the parallel marker by the full collection.
+  marking->Step(100 * KB, IncrementalMarking::NO_GC_VIA_STACK_GUARD);
+  CHECK(marking->IsMarking());
+  CHECK(!marking->marking_deque()->IsEmpty());
+  heap->CollectAllGarbage(Heap::kNoGCFlags, "test parallel marking");
+  CheckObjectGraph();
+}
+
+
+TEST(ParallelPointerUpdate) {
+  if (FLAG_never_compact) return;
+  FLAG_parallel_pointer_update = true;
+  FLAG_always_compact = true;
+  CcTest::InitializeVM();
+  CcTest::i_isolate()->set_max_available_threads(4);
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+
+  CreateObjectGraph();
+  heap->CollectAllGarbage(Heap::kNoGCFlags, "test parallel pointer update");
+  // Replace every other list by a copy to fragment old space, so that live
+  // objects get evacuated.
+  CompileRun(
+      "function copy(list) {"
+      "  if (list == null) return null;"
+      "  return { next: copy(list.next), value: list.value, name: list.name,"
+      "           array: list.array, f: list.f };"
+      "}"
+      "for (var i = 0; i < roots.length; i += 2) roots[i] = copy(roots[i]);");
+  for (int i = 0; i < 3; i++) {
+    heap->CollectAllGarbage(Heap::kNoGCFlags, "test parallel pointer update");
+  }
+  CheckObjectGraph();
+}
+
+
 // TODO(1600): compaction of map space is temporary removed from GC.
 #if 0
 static Handle<Map> CreateMap(Isolate* isolate) {
@@ -664,6 +664,94 @@ DEPENDENT_TEST(DependentTestThatAlwaysFails, TestThatAlwaysSucceeds) {
 }
 
 
+TEST(SnapshotDataBlobWithCustomSource) {
+  v8::StartupData plain = v8::V8::CreateSnapshotDataBlob();
+  CHECK(plain.data != NULL);
+  v8::StartupData custom = v8::V8::CreateSnapshotDataBlob(
+      "var o = { x: 42 };"
+      "function f() { return o.x; }");
+  CHECK(custom.data != NULL);
+  // The custom snapshot additionally contains the script's global state.
+  CHECK_GT(custom.raw_size, plain.raw_size);
+  CHECK_EQ(custom.raw_size,
+           WriteBytes(FLAG_testing_serialization_file,
+                      reinterpret_cast<const byte*>(custom.data),
+                      custom.raw_size));
+  delete[] plain.data;
+  delete[] custom.data;
+
+  v8::StartupData failed = v8::V8::CreateSnapshotDataBlob("throw 42;");
+  CHECK(failed.data == NULL);
+}
+
+
+// Reads the space reservations that follow each part of a startup blob.
+static void ReserveSpaceFromBlob(SnapshotByteSource* blob,
+                                 Deserializer* deserializer) {
+  static const int kSpaces[] = {
+      NEW_SPACE, OLD_POINTER_SPACE, OLD_DATA_SPACE, CODE_SPACE,
+      MAP_SPACE, CELL_SPACE,        PROPERTY_CELL_SPACE
+  };
+  for (size_t i = 0; i < ARRAY_SIZE(kSpaces); ++i) {
+    deserializer->set_reservation(kSpaces[i], blob->GetInt());
+  }
+}
+
+
+DEPENDENT_TEST(SnapshotDataBlobDeserialization,
+               SnapshotDataBlobWithCustomSource) {
+  if (!Snapshot::HaveASnapshotToStartFrom()) {
+    v8::Isolate* v8_isolate = CcTest::isolate();
+    v8::HandleScope handle_scope(v8_isolate);
+    Isolate* isolate = CcTest::i_isolate();
+
+    int blob_size = 0;
+    byte* blob_data = ReadBytes(FLAG_testing_serialization_file, &blob_size);
+    CHECK(blob_data != NULL);
+    SnapshotByteSource blob(blob_data, blob_size);
+
+    const byte* startup_data;
+    int startup_size;
+    CHECK(blob.GetBlob(&startup_data, &startup_size));
+    {
+      SnapshotByteSource source(startup_data, startup_size);
+      Deserializer deserializer(&source);
+      ReserveSpaceFromBlob(&blob, &deserializer);
+      CHECK(V8::Initialize(&deserializer));
+    }
+
+    const byte* context_data;
+    int context_size;
+    CHECK(blob.GetBlob(&context_data, &context_size));
+    Object* root;
+    {
+      SnapshotByteSource source(context_data, context_size);
+      Deserializer deserializer(&source);
+      ReserveSpaceFromBlob(&blob, &deserializer);
+      deserializer.DeserializePartial(isolate, &root);
+      CHECK(root->IsContext());
+    }
+    DeleteArray(blob_data);
+
+    // The custom source's functions and objects survive the round trip.
+    HandleScope scope(isolate);
+    Handle<Context> context(Context::cast(root), isolate);
+    SaveContext save(isolate);
+    isolate->set_context(*context);
+    Handle<Object> global(context->global_object(), isolate);
+    Handle<Object> f =
+        Object::GetProperty(global,
+                            isolate->factory()->InternalizeUtf8String("f"))
+            .ToHandleChecked();
+    CHECK(f->IsJSFunction());
+    Handle<Object> receiver(context->global_proxy(), isolate);
+    Handle<Object> result =
+        Execution::Call(isolate, f, receiver, 0, NULL).ToHandleChecked();
+    CHECK_EQ(42, Smi::cast(*result)->value());
+  }
+}
+
+
 int CountBuiltins() {
   // Check that we have not deserialized any additional builtin.
   HeapIterator iterator(CcTest::heap());
@@ -844,3 +932,143 @@ TEST(SerializeToplevelIsolates) {
   }
   isolate2->Dispose();
 }
+
+
+static int CountCompiledFunctions(Isolate* isolate, Handle<Script> script) {
+  int count = 0;
+  HeapIterator iterator(isolate->heap());
+  for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    if (shared->script() == *script && shared->is_compiled()) count++;
+  }
+  return count;
+}
+
+
+TEST(SerializeToplevelAfterWarmUp) {
+  FLAG_serialize_toplevel = true;
+
+  const char* source =
+      "function f() { return 'abc'; };"
+      "function g() { return f() + 'def'; };"
+      "g()";
+  v8::ScriptCompiler::CachedData* cold_cache;
+  v8::ScriptCompiler::CachedData* warm_cache;
+
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  v8::Isolate* isolate2 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+        isolate1, &source, v8::ScriptCompiler::kProduceCodeCache);
+    const v8::ScriptCompiler::CachedData* data = source.GetCachedData();
+    uint8_t* buffer = NewArray<uint8_t>(data->length);
+    MemCopy(buffer, data->data, data->length);
+    cold_cache = new v8::ScriptCompiler::CachedData(
+        buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+
+    v8::Local<v8::Value> result = script->BindToCurrentContext()->Run();
+    CHECK(result->ToString()->Equals(v8_str("abcdef")));
+
+    // f and g have been compiled lazily while running the script.
+    warm_cache = v8::ScriptCompiler::CreateCodeCache(script);
+    CHECK(warm_cache != NULL);
+    CHECK_GT(warm_cache->length, cold_cache->length);
+  }
+  isolate1->Dispose();
+  delete cold_cache;
+
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, warm_cache);
+    {
+      DisallowCompilation no_compile(i_isolate);
+      v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+          isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache);
+      CHECK(!source.GetCachedData()->rejected);
+
+      // The top-level code, f and g come out of the cache compiled.
+      Handle<SharedFunctionInfo> toplevel =
+          Handle<SharedFunctionInfo>::cast(v8::Utils::OpenHandle(*script));
+      Handle<Script> i_script(Script::cast(toplevel->script()));
+      CHECK_EQ(3, CountCompiledFunctions(i_isolate, i_script));
+
+      v8::Local<v8::Value> result = script->BindToCurrentContext()->Run();
+      CHECK(result->ToString()->Equals(v8_str("abcdef")));
+    }
+  }
+  isolate2->Dispose();
+}
+
+
+static v8::ScriptCompiler::CachedData* ProduceCache(const char* source) {
+  v8::ScriptCompiler::Source script_source(v8_str(source));
+  v8::ScriptCompiler::CompileUnbound(CcTest::isolate(), &script_source,
+                                     v8::ScriptCompiler::kProduceCodeCache);
+  const v8::ScriptCompiler::CachedData* data = script_source.GetCachedData();
+  uint8_t* buffer = NewArray<uint8_t>(data->length);
+  MemCopy(buffer, data->data, data->length);
+  return new v8::ScriptCompiler::CachedData(
+      buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+}
+
+
+static bool ConsumeCacheRejected(const char* source,
+                                 v8::ScriptCompiler::CachedData* cache) {
+  v8::ScriptCompiler::Source script_source(v8_str(source), cache);
+  v8::Local<v8::UnboundScript> script = v8::ScriptCompiler::CompileUnbound(
+      CcTest::isolate(), &script_source,
+      v8::ScriptCompiler::kConsumeCodeCache);
+  v8::Local<v8::Value> result = script->BindToCurrentContext()->Run();
+  CHECK_EQ(2, result->Int32Value());
+  return script_source.GetCachedData()->rejected;
+}
+
+
+TEST(SerializeToplevelRejectCorruptedData) {
+  FLAG_serialize_toplevel = true;
+  CcTest::i_isolate()->compilation_cache()->Disable();
+  LocalContext context;
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source = "1 + 1";
+  v8::ScriptCompiler::CachedData* cache = ProduceCache(source);
+  CHECK(!ConsumeCacheRejected(source, cache));
+
+  cache = ProduceCache(source);
+  const_cast<uint8_t*>(cache->data)[cache->length - 1] ^= 0xff;
+  CHECK(ConsumeCacheRejected(source, cache));
+
+  // Same length, different contents.
+  cache = ProduceCache(source);
+  CHECK(ConsumeCacheRejected("2 * 1", cache));
+}
+
+
+TEST(SerializeToplevelRejectChangedFlags) {
+  FLAG_serialize_toplevel = true;
+  CcTest::i_isolate()->compilation_cache()->Disable();
+  LocalContext context;
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source = "1 + 1";
+  v8::ScriptCompiler::CachedData* cache = ProduceCache(source);
+  FLAG_max_inlining_levels++;
+  CHECK(ConsumeCacheRejected(source, cache));
+  FLAG_max_inlining_levels--;
+}
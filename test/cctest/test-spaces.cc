@@ -372,6 +372,48 @@ TEST(OldSpace) {
 }
 
 
+TEST(FreeListConcurrentHandoff) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  PagedSpace* s = heap->old_data_space();
+  AlwaysAllocateScope always_allocate(CcTest::i_isolate());
+
+  // Two sweepers free a block for each free list category and hand their
+  // free lists over to the space owner through a shared free list.
+  FreeList first_sweeper(s);
+  FreeList second_sweeper(s);
+  FreeList shared(s);
+  FreeList owner(s);
+  const int kSizes[] = {64 * kPointerSize, 512 * kPointerSize,
+                        4096 * kPointerSize, 20000 * kPointerSize};
+  intptr_t freed_bytes = 0;
+  for (size_t i = 0; i < ARRAY_SIZE(kSizes); i++) {
+    for (int j = 0; j < 2; j++) {
+      HeapObject* block =
+          HeapObject::cast(s->AllocateRaw(kSizes[i]).ToObjectChecked());
+      FreeList* free_list = j == 0 ? &first_sweeper : &second_sweeper;
+      freed_bytes += kSizes[i] - free_list->Free(block->address(), kSizes[i]);
+    }
+  }
+
+  shared.AddConcurrently(&first_sweeper);
+  shared.AddConcurrently(&second_sweeper);
+  CHECK(first_sweeper.IsEmpty());
+  CHECK(second_sweeper.IsEmpty());
+  CHECK(!shared.IsEmpty());
+
+  CHECK_EQ(freed_bytes, owner.TakeConcurrentlyAdded(&shared));
+  CHECK(shared.IsEmpty());
+  CHECK_EQ(freed_bytes, owner.available());
+  CHECK_EQ(static_cast<intptr_t>(0), owner.TakeConcurrentlyAdded(&shared));
+
+  CHECK_EQ(2 * kSizes[0], owner.small_list()->available());
+  CHECK_EQ(2 * kSizes[1], owner.medium_list()->available());
+  CHECK_EQ(2 * kSizes[2], owner.large_list()->available());
+  CHECK_EQ(2 * kSizes[3], owner.huge_list()->available());
+}
+
+
 TEST(LargeObjectSpace) {
   v8::V8::Initialize();
 
@@ -431,3 +473,27 @@ TEST(SizeOfFirstPageIsLargeEnough) {
   // No large objects required to perform the above steps.
   CHECK(isolate->heap()->lo_space()->IsEmpty());
 }
+
+
+TEST(LargeObjectSpaceHugePageAlignment) {
+  FLAG_transparent_huge_pages = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+
+  int length = static_cast<int>(MemoryAllocator::kHugePageSize / kPointerSize);
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(length);
+  CHECK(isolate->heap()->lo_space()->Contains(*array));
+  MemoryChunk* chunk = MemoryChunk::FromAddress(array->address());
+  CHECK(IsAddressAligned(chunk->address(), MemoryAllocator::kHugePageSize));
+
+  // The advised memory must behave like regular heap memory across GCs. Any
+  // speedup of the GC is not checked: whether the kernel backs the region
+  // with huge pages depends on its transparent huge page settings, and GC
+  // times are too noisy for a pass/fail test.
+  for (int i = 0; i < length; i++) array->set(i, Smi::FromInt(i));
+  isolate->heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK(isolate->heap()->lo_space()->Contains(*array));
+  CHECK_EQ(Smi::FromInt(length - 1), array->get(length - 1));
+  FLAG_transparent_huge_pages = false;
+}
@@ -53,6 +53,18 @@ TEST_F(CommonOperatorTest, Finish) {
   }
 }
 
+
+TEST_F(CommonOperatorTest, HeapConstant) {
+  Handle<Object> old_value = factory()->undefined_value();
+  Handle<Object> new_value = factory()->NewFixedArray(1);
+  Operator* old_op = common()->HeapConstant(
+      PrintableUnique<Object>::CreateUninitialized(zone(), old_value));
+  Operator* new_op = common()->HeapConstant(
+      PrintableUnique<Object>::CreateUninitialized(zone(), new_value));
+  EXPECT_FALSE(static_cast<HeapConstantOperator*>(old_op)->InNewSpace());
+  EXPECT_TRUE(static_cast<HeapConstantOperator*>(new_op)->InNewSpace());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
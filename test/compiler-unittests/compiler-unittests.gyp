@@ -29,6 +29,9 @@
         'instruction-selector-unittest.cc',
         'machine-operator-reducer-unittest.cc',
         'machine-operator-unittest.cc',
+        'node-unittest.cc',
+        'typer-unittest.cc',
+        'value-numbering-reducer-unittest.cc',
       ],
       'conditions': [
         ['v8_target_arch=="arm"', {
@@ -0,0 +1,127 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/compiler/generic-node-inl.h"
+#include "src/compiler/graph-reducer.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node.h"
+#include "test/compiler-unittests/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class NodeTest : public GraphTest {
+ public:
+  NodeTest() : GraphTest(2), machine_(zone()) {}
+  virtual ~NodeTest() {}
+
+ protected:
+  Node* Parameter(int32_t index) {
+    return graph()->NewNode(common()->Parameter(index), graph()->start());
+  }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+};
+
+
+TEST_F(NodeTest, AppendInputKeepsUseLists) {
+  Node* p0 = Parameter(0);
+  Node* p1 = Parameter(1);
+  Node* merge = graph()->NewNode(common()->Merge(1), graph()->start());
+  for (int i = 0; i < 10; ++i) {
+    merge->AppendInput(zone(), (i % 2) ? p1 : p0);
+  }
+  ASSERT_EQ(11, merge->InputCount());
+  EXPECT_EQ(graph()->start(), merge->InputAt(0));
+  for (int i = 1; i < merge->InputCount(); ++i) {
+    EXPECT_EQ(((i - 1) % 2) ? p1 : p0, merge->InputAt(i));
+  }
+  EXPECT_EQ(5, p0->UseCount());
+  EXPECT_EQ(5, p1->UseCount());
+  for (Node::Uses::iterator i = p0->uses().begin(); i != p0->uses().end();
+       ++i) {
+    EXPECT_EQ(merge, i.edge().from());
+    EXPECT_EQ(p0, merge->InputAt(i.edge().index()));
+  }
+}
+
+
+TEST_F(NodeTest, TrimInputCountThenAppendInput) {
+  Node* p0 = Parameter(0);
+  Node* p1 = Parameter(1);
+  Node* add = graph()->NewNode(machine()->Int32Add(), p0, p1);
+  add->TrimInputCount(1);
+  EXPECT_EQ(1, add->InputCount());
+  EXPECT_EQ(0, p1->UseCount());
+  add->AppendInput(zone(), p0);
+  ASSERT_EQ(2, add->InputCount());
+  EXPECT_EQ(p0, add->InputAt(0));
+  EXPECT_EQ(p0, add->InputAt(1));
+  EXPECT_EQ(2, p0->UseCount());
+  EXPECT_EQ(0, p1->UseCount());
+}
+
+
+namespace {
+
+// Touches every input of every node, which is what most reducers do.
+class InputVisitingReducer V8_FINAL : public Reducer {
+ public:
+  InputVisitingReducer() : input_count_(0) {}
+
+  virtual Reduction Reduce(Node* node) V8_OVERRIDE {
+    for (InputIter i = node->inputs().begin(); i != node->inputs().end();
+         ++i) {
+      if (*i != NULL) input_count_++;
+    }
+    return NoChange();
+  }
+
+  int input_count() const { return input_count_; }
+
+ private:
+  int input_count_;
+};
+
+}  // namespace
+
+
+// Microbenchmark for reducer throughput on a large graph. Disabled by default,
+// run with --gtest_also_run_disabled_tests to compare node layouts.
+TEST_F(NodeTest, DISABLED_ReducerThroughput) {
+  static const int kNodeCount = 100000;
+  static const int kIterations = 10;
+  Node* p0 = Parameter(0);
+  Node* p1 = Parameter(1);
+  Node* value = p0;
+  for (int i = 0; i < kNodeCount; ++i) {
+    value = graph()->NewNode(machine()->Int32Add(), value, p1);
+  }
+  graph()->SetEnd(graph()->NewNode(common()->End(), value));
+
+  base::ElapsedTimer timer;
+  timer.Start();
+  int input_count = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    InputVisitingReducer reducer;
+    GraphReducer graph_reducer(graph());
+    graph_reducer.AddReducer(&reducer);
+    graph_reducer.ReduceGraph();
+    input_count += reducer.input_count();
+  }
+  double ms = timer.Elapsed().InMillisecondsF();
+  EXPECT_LT(kIterations * 2 * kNodeCount, input_count);
+  PrintF("Reduced %d nodes in %.3f ms (%.0f nodes/sec)\n",
+         kIterations * graph()->NodeCount(), ms,
+         kIterations * graph()->NodeCount() * 1000.0 / ms);
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
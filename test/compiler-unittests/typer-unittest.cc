@@ -0,0 +1,89 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/js-operator.h"
+#include "src/compiler/node-properties-inl.h"
+#include "src/compiler/typer.h"
+#include "test/compiler-unittests/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class TyperTest : public GraphTest {
+ public:
+  TyperTest() : GraphTest(1), javascript_(zone()), typer_(zone()) {}
+  virtual ~TyperTest() {}
+
+ protected:
+  // Builds the graph of
+  //
+  //   for (var i = initial; i < limit; i = i + 1) {}
+  //   return i;
+  //
+  // with {compare} as the loop test, and returns the phi for i.
+  Node* CountingLoop(Operator* compare, double initial, double limit) {
+    Node* start = graph()->start();
+    Node* context = graph()->NewNode(common()->Parameter(0), start);
+    Node* loop = graph()->NewNode(common()->Loop(2), start, start);
+    Node* phi = graph()->NewNode(common()->Phi(2), NumberConstant(initial),
+                                 NumberConstant(initial), loop);
+    Node* test = graph()->NewNode(compare, phi, NumberConstant(limit),
+                                  context, start, loop);
+    Node* branch = graph()->NewNode(
+        common()->Branch(),
+        graph()->NewNode(javascript()->ToBoolean(), test, context, start, loop),
+        loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    Node* increment = graph()->NewNode(javascript()->Add(), phi,
+                                       NumberConstant(1), context, start,
+                                       if_true);
+    loop->ReplaceInput(1, if_true);
+    phi->ReplaceInput(1, increment);
+    Node* ret = graph()->NewNode(common()->Return(), phi, start, if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(), ret));
+    return phi;
+  }
+
+  Type* TypeOf(Node* node) {
+    typer_.Run(graph(), MaybeHandle<Context>());
+    return NodeProperties::GetBounds(node).upper;
+  }
+
+  Node* NumberConstant(double value) {
+    return graph()->NewNode(common()->NumberConstant(value));
+  }
+
+  JSOperatorBuilder* javascript() { return &javascript_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  Typer typer_;
+};
+
+
+TEST_F(TyperTest, InductionVariableBelowLimit) {
+  Node* phi = CountingLoop(javascript()->LessThan(), 0, 100);
+  EXPECT_TRUE(TypeOf(phi)->Is(Type::Unsigned32()));
+}
+
+
+TEST_F(TyperTest, InductionVariableWithNegativeStart) {
+  Node* phi = CountingLoop(javascript()->LessThan(), -10, 100);
+  Type* type = TypeOf(phi);
+  EXPECT_TRUE(type->Is(Type::Signed32()));
+  EXPECT_FALSE(type->Is(Type::Unsigned32()));
+}
+
+
+TEST_F(TyperTest, InductionVariableUpToLimitIsNotBounded) {
+  // With i <= limit the increment can go past the limit.
+  Node* phi = CountingLoop(javascript()->LessThanOrEqual(), 0, 100);
+  EXPECT_FALSE(TypeOf(phi)->Is(Type::Signed32()));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,101 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/value-numbering-reducer.h"
+#include "test/compiler-unittests/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class ValueNumberingReducerTest : public GraphTest {
+ public:
+  ValueNumberingReducerTest()
+      : GraphTest(2), machine_(zone()), reducer_(zone()) {}
+  virtual ~ValueNumberingReducerTest() {}
+
+ protected:
+  Node* Parameter(int32_t index) {
+    return graph()->NewNode(common()->Parameter(index), graph()->start());
+  }
+
+  Reduction Reduce(Node* node) { return reducer_.Reduce(node); }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+  ValueNumberingReducer reducer_;
+};
+
+
+TEST_F(ValueNumberingReducerTest, EqualNodesAreReplaced) {
+  Node* p0 = Parameter(0);
+  Node* p1 = Parameter(1);
+  Node* add1 = graph()->NewNode(machine()->Int32Add(), p0, p1);
+  Node* add2 = graph()->NewNode(machine()->Int32Add(), p0, p1);
+  EXPECT_FALSE(Reduce(add1).Changed());
+  Reduction r = Reduce(add2);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(add1, r.replacement());
+}
+
+
+TEST_F(ValueNumberingReducerTest, DifferentInputsAreNotReplaced) {
+  Node* p0 = Parameter(0);
+  Node* p1 = Parameter(1);
+  Node* add1 = graph()->NewNode(machine()->Int32Add(), p0, p1);
+  Node* add2 = graph()->NewNode(machine()->Int32Add(), p1, p0);
+  Node* sub = graph()->NewNode(machine()->Int32Sub(), p0, p1);
+  EXPECT_FALSE(Reduce(add1).Changed());
+  EXPECT_FALSE(Reduce(add2).Changed());
+  EXPECT_FALSE(Reduce(sub).Changed());
+}
+
+
+TEST_F(ValueNumberingReducerTest, ReducingTwiceIsNoChange) {
+  Node* add = graph()->NewNode(machine()->Int32Add(), Parameter(0),
+                               Parameter(1));
+  EXPECT_FALSE(Reduce(add).Changed());
+  EXPECT_FALSE(Reduce(add).Changed());
+}
+
+
+TEST_F(ValueNumberingReducerTest, LoadsRespectEffectChain) {
+  Node* base = Parameter(0);
+  Node* index = Parameter(1);
+  Node* start = graph()->start();
+  Node* load1 =
+      graph()->NewNode(machine()->Load(kMachInt32), base, index, start);
+  Node* store = graph()->NewNode(
+      machine()->Store(kMachInt32, kNoWriteBarrier), base, index, index,
+      load1, start);
+  Node* load2 =
+      graph()->NewNode(machine()->Load(kMachInt32), base, index, store);
+  Node* load3 =
+      graph()->NewNode(machine()->Load(kMachInt32), base, index, store);
+  EXPECT_FALSE(Reduce(load1).Changed());
+  EXPECT_FALSE(Reduce(store).Changed());
+  EXPECT_FALSE(Reduce(load2).Changed());
+  Reduction r = Reduce(load3);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(load2, r.replacement());
+}
+
+
+TEST_F(ValueNumberingReducerTest, StoresAreNotReplaced) {
+  Node* base = Parameter(0);
+  Node* index = Parameter(1);
+  Node* start = graph()->start();
+  Node* store1 = graph()->NewNode(machine()->Store(kMachInt32, kNoWriteBarrier),
+                                  base, index, index, start, start);
+  Node* store2 = graph()->NewNode(machine()->Store(kMachInt32, kNoWriteBarrier),
+                                  base, index, index, start, start);
+  EXPECT_FALSE(Reduce(store1).Changed());
+  EXPECT_FALSE(Reduce(store2).Changed());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -38,6 +38,119 @@ TEST_F(InstructionSelectorTest, TruncateInt64ToInt32WithParameter) {
   EXPECT_EQ(kX64Movl, s[0]->arch_opcode());
 }
 
+
+// -----------------------------------------------------------------------------
+// Loads and stores.
+
+
+TEST_F(InstructionSelectorTest, LoadFloat64WithScaledIndexAndDisplacement) {
+  StreamBuilder m(this, kMachFloat64, kMachPtr, kMachInt32);
+  Node* const key = m.Word32And(m.Parameter(1), m.Int32Constant(0xffff));
+  Node* const index =
+      m.Int32Add(m.Int32Mul(key, m.Int32Constant(8)), m.Int32Constant(16));
+  m.Return(m.Load(kMachFloat64, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(2U, s.size());
+  EXPECT_EQ(kX64And32, s[0]->arch_opcode());
+  EXPECT_EQ(kSSELoad, s[1]->arch_opcode());
+  EXPECT_EQ(kMode_MR8I, s[1]->addressing_mode());
+  ASSERT_EQ(3U, s[1]->InputCount());
+  EXPECT_EQ(16, s.ToInt32(s[1]->InputAt(2)));
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWord32WithShiftedIndex) {
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachInt32);
+  Node* const key = m.Word32Shr(m.Parameter(1), m.Int32Constant(4));
+  Node* const index = m.Word32Shl(key, m.Int32Constant(2));
+  m.Return(m.Load(kMachInt32, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(2U, s.size());
+  EXPECT_EQ(kX64Shr32, s[0]->arch_opcode());
+  EXPECT_EQ(kX64LoadWord32, s[1]->arch_opcode());
+  EXPECT_EQ(kMode_MR4I, s[1]->addressing_mode());
+  ASSERT_EQ(3U, s[1]->InputCount());
+  EXPECT_EQ(0, s.ToInt32(s[1]->InputAt(2)));
+}
+
+
+TEST_F(InstructionSelectorTest, StoreFloat64WithScaledIndexAndDisplacement) {
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachInt32, kMachFloat64);
+  Node* const key = m.Word32And(m.Parameter(1), m.Int32Constant(0xffff));
+  Node* const index =
+      m.Int32Add(m.Int32Mul(key, m.Int32Constant(8)), m.Int32Constant(16));
+  m.Store(kMachFloat64, m.Parameter(0), index, m.Parameter(2));
+  m.Return(m.Int32Constant(0));
+  Stream s = m.Build();
+  ASSERT_EQ(2U, s.size());
+  EXPECT_EQ(kSSEStore, s[1]->arch_opcode());
+  EXPECT_EQ(kMode_MR8I, s[1]->addressing_mode());
+  ASSERT_EQ(4U, s[1]->InputCount());
+  EXPECT_EQ(16, s.ToInt32(s[1]->InputAt(2)));
+  EXPECT_EQ(0U, s[1]->OutputCount());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithUnscalableIndex) {
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachInt32);
+  Node* const key = m.Word32And(m.Parameter(1), m.Int32Constant(0xffff));
+  Node* const index = m.Int32Mul(key, m.Int32Constant(3));
+  m.Return(m.Load(kMachInt32, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(3U, s.size());
+  EXPECT_EQ(kX64LoadWord32, s[2]->arch_opcode());
+  EXPECT_EQ(kMode_MR1I, s[2]->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithParameterIndex) {
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachInt32);
+  m.Return(m.Load(kMachInt32, m.Parameter(0), m.Parameter(1)));
+  Stream s = m.Build();
+  ASSERT_EQ(1U, s.size());
+  EXPECT_EQ(kX64LoadWord32, s[0]->arch_opcode());
+  EXPECT_EQ(kMode_MR1I, s[0]->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithParameterPlusConstantIndex) {
+  StreamBuilder m(this, kMachInt32, kMachPtr, kMachInt32);
+  Node* const index = m.Int32Add(m.Parameter(1), m.Int32Constant(16));
+  m.Return(m.Load(kMachInt32, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(2U, s.size());
+  EXPECT_EQ(kX64Add32, s[0]->arch_opcode());
+  EXPECT_EQ(kX64LoadWord32, s[1]->arch_opcode());
+  EXPECT_EQ(kMode_MR1I, s[1]->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithUnboundedScaledIndex) {
+  // The multiplication may wrap around in 32 bits, so it must not be folded
+  // into the 64-bit address computation.
+  StreamBuilder m(this, kMachFloat64, kMachPtr, kMachInt32);
+  Node* const index =
+      m.Int32Add(m.Int32Mul(m.Parameter(1), m.Int32Constant(8)),
+                 m.Int32Constant(16));
+  m.Return(m.Load(kMachFloat64, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(3U, s.size());
+  EXPECT_EQ(kSSELoad, s[2]->arch_opcode());
+  EXPECT_EQ(kMode_MR1I, s[2]->addressing_mode());
+}
+
+
+TEST_F(InstructionSelectorTest, LoadWithScaledIndexOutOfRange) {
+  StreamBuilder m(this, kMachFloat64, kMachPtr, kMachInt32);
+  Node* const key = m.Word32Shr(m.Parameter(1), m.Int32Constant(1));
+  Node* const index = m.Word32Shl(key, m.Int32Constant(3));
+  m.Return(m.Load(kMachFloat64, m.Parameter(0), index));
+  Stream s = m.Build();
+  ASSERT_EQ(3U, s.size());
+  EXPECT_EQ(kSSELoad, s[2]->arch_opcode());
+  EXPECT_EQ(kMode_MR1I, s[2]->addressing_mode());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -4,6 +4,7 @@
 
 #include <limits>
 
+#include "src/flags.h"
 #include "src/heap/gc-idle-time-handler.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
@@ -45,5 +46,268 @@ TEST(EstimateMarkingStepSizeTest, EstimateMarkingStepSizeOverflow2) {
             step_size);
 }
 
+
+TEST(EstimateMarkCompactTimeTest, EstimateMarkCompactTimeInitial) {
+  size_t size = 100 * MB;
+  size_t time = GCIdleTimeHandler::EstimateMarkCompactTime(size, 0);
+  EXPECT_EQ(size / GCIdleTimeHandler::kInitialConservativeMarkCompactSpeed,
+            time);
+}
+
+
+TEST(EstimateMarkCompactTimeTest, EstimateMarkCompactTimeNonZero) {
+  size_t size = 100 * MB;
+  size_t speed = 10 * KB;
+  size_t time = GCIdleTimeHandler::EstimateMarkCompactTime(size, speed);
+  EXPECT_EQ(size / speed, time);
+}
+
+
+TEST(EstimateMarkCompactTimeTest, EstimateMarkCompactTimeMax) {
+  size_t size = std::numeric_limits<size_t>::max();
+  size_t speed = 1;
+  size_t time = GCIdleTimeHandler::EstimateMarkCompactTime(size, speed);
+  EXPECT_EQ(static_cast<size_t>(GCIdleTimeHandler::kMaxMarkCompactTimeInMs),
+            time);
+}
+
+
+TEST(EstimateScavengeTimeTest, EstimateScavengeTimeInitial) {
+  size_t size = 1 * MB;
+  size_t time = GCIdleTimeHandler::EstimateScavengeTime(size, 0);
+  EXPECT_EQ(size / GCIdleTimeHandler::kInitialConservativeScavengeSpeed, time);
+}
+
+
+TEST(EstimateScavengeTimeTest, EstimateScavengeTimeNonZero) {
+  size_t size = 1 * MB;
+  size_t speed = 1 * MB;
+  size_t time = GCIdleTimeHandler::EstimateScavengeTime(size, speed);
+  EXPECT_EQ(size / speed, time);
+}
+
+
+TEST(ScavengeMayHappenSoonTest, ScavengeMayHappenSoon) {
+  size_t capacity = 1 * MB;
+  EXPECT_FALSE(GCIdleTimeHandler::ScavengeMayHappenSoon(0, capacity));
+  EXPECT_FALSE(
+      GCIdleTimeHandler::ScavengeMayHappenSoon(capacity / 2, capacity));
+  EXPECT_TRUE(GCIdleTimeHandler::ScavengeMayHappenSoon(capacity, capacity));
+}
+
+
+class GCIdleTimeHandlerTest : public ::testing::Test {
+ public:
+  GCIdleTimeHandlerTest() {}
+  virtual ~GCIdleTimeHandlerTest() {}
+
+  GCIdleTimeHandler* handler() { return &handler_; }
+
+  GCIdleTimeHandler::HeapState DefaultHeapState() {
+    GCIdleTimeHandler::HeapState result;
+    result.contexts_disposed = 0;
+    result.size_of_objects = kSizeOfObjects;
+    result.incremental_marking_stopped = false;
+    result.can_start_incremental_marking = true;
+    result.sweeping_in_progress = false;
+    result.mark_compact_speed_in_bytes_per_ms = kMarkCompactSpeed;
+    result.incremental_marking_speed_in_bytes_per_ms = kMarkingSpeed;
+    result.scavenge_speed_in_bytes_per_ms = kScavengeSpeed;
+    result.used_new_space_size = 0;
+    result.new_space_capacity = kNewSpaceCapacity;
+    return result;
+  }
+
+  static const size_t kSizeOfObjects = 100 * MB;
+  static const size_t kMarkCompactSpeed = 100 * KB;
+  static const size_t kMarkingSpeed = 100 * KB;
+  static const size_t kScavengeSpeed = 100 * KB;
+  static const size_t kNewSpaceCapacity = 1 * MB;
+
+ private:
+  GCIdleTimeHandler handler_;
+};
+
+
+TEST_F(GCIdleTimeHandlerTest, IncrementalMarking) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  size_t idle_time_in_ms = 10;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+  EXPECT_EQ(GCIdleTimeHandler::EstimateMarkingStepSize(idle_time_in_ms,
+                                                       kMarkingSpeed),
+            static_cast<size_t>(action.parameter));
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, StartIncrementalMarking) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = 10;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ContextDisposed) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.contexts_disposed = 1;
+  heap_state.size_of_objects = 10 * MB;
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = heap_state.size_of_objects /
+                           heap_state.mark_compact_speed_in_bytes_per_ms;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_FULL_GC, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ContextDisposedNotEnoughTime) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.contexts_disposed = 1;
+  heap_state.size_of_objects = 10 * MB;
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = heap_state.size_of_objects /
+                               heap_state.mark_compact_speed_in_bytes_per_ms -
+                           1;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, ContextDisposedWithExposeGC) {
+  bool old_expose_gc = FLAG_expose_gc;
+  FLAG_expose_gc = true;
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.contexts_disposed = 1;
+  heap_state.size_of_objects = 10 * MB;
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = heap_state.size_of_objects /
+                           heap_state.mark_compact_speed_in_bytes_per_ms;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+  FLAG_expose_gc = old_expose_gc;
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, CannotStartIncrementalMarking) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.can_start_incremental_marking = false;
+  size_t idle_time_in_ms = 10;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_NOTHING, action.type);
+
+  idle_time_in_ms = GCIdleTimeHandler::kMaxMarkCompactTimeInMs;
+  action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_FULL_GC, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, Scavenge) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = heap_state.new_space_capacity;
+  size_t idle_time_in_ms = heap_state.used_new_space_size /
+                           heap_state.scavenge_speed_in_bytes_per_ms;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_SCAVENGE, action.type);
+
+  action = handler()->Compute(idle_time_in_ms - 1, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, FinalizeSweeping) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.sweeping_in_progress = true;
+  size_t idle_time_in_ms = GCIdleTimeHandler::kMinTimeForFinalizeSweeping;
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_FINALIZE_SWEEPING, action.type);
+
+  action = handler()->Compute(idle_time_in_ms - 1, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, FullGCAtEndOfIdleRound) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = GCIdleTimeHandler::kMaxMarkCompactTimeInMs;
+  for (int i = 0; i < GCIdleTimeHandler::kMaxMarkCompactsInIdleRound - 2;
+       i++) {
+    GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+    EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+    handler()->NotifyIdleMarkCompact();
+  }
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_FULL_GC, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, IdleRound) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  size_t idle_time_in_ms = 10;
+  for (int i = 0; i < GCIdleTimeHandler::kMaxMarkCompactsInIdleRound; i++) {
+    GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+    EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+    handler()->NotifyIdleMarkCompact();
+  }
+  EXPECT_TRUE(handler()->IsIdleRoundFinished());
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DONE, action.type);
+
+  // Enough garbage created by the mutator starts a new idle round.
+  for (int i = 0; i < GCIdleTimeHandler::kIdleScavengeThreshold; i++) {
+    handler()->NotifyScavenge();
+  }
+  action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+  EXPECT_FALSE(handler()->IsIdleRoundFinished());
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, MemoryReducer) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  size_t idle_time_in_ms = GCIdleTimeHandler::kMaxMarkCompactTimeInMs;
+  for (int i = 0; i < GCIdleTimeHandler::kMaxMarkCompactsInIdleRound; i++) {
+    handler()->NotifyIdleMarkCompact();
+  }
+  EXPECT_TRUE(handler()->IsIdleRoundFinished());
+
+  handler()->StartMemoryReducer();
+  EXPECT_FALSE(handler()->IsIdleRoundFinished());
+  for (int i = 0; i < GCIdleTimeHandler::kMemoryReducerMarkCompacts; i++) {
+    GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+    EXPECT_EQ(DO_FULL_GC, action.type);
+    EXPECT_TRUE(handler()->IsMemoryReducerActive());
+    handler()->NotifyIdleMarkCompact();
+  }
+  GCIdleTimeAction action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_RELEASE_MEMORY, action.type);
+  EXPECT_FALSE(handler()->IsMemoryReducerActive());
+  EXPECT_TRUE(handler()->IsIdleRoundFinished());
+
+  action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DONE, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, MemoryReducerNotEnoughTime) {
+  GCIdleTimeHandler::HeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  handler()->StartMemoryReducer();
+  GCIdleTimeAction action = handler()->Compute(0, heap_state);
+  EXPECT_EQ(DO_NOTHING, action.type);
+
+  size_t idle_time_in_ms = 10;
+  action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_MARKING, action.type);
+
+  heap_state.can_start_incremental_marking = false;
+  action = handler()->Compute(idle_time_in_ms, heap_state);
+  EXPECT_EQ(DO_NOTHING, action.type);
+}
+
 }  // namespace internal
 }  // namespace v8
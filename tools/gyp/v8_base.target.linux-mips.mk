@@ -120,7 +120,6 @@ LOCAL_SRC_FILES := \
 	v8/src/heap/objects-visiting.cc \
 	v8/src/heap/spaces.cc \
 	v8/src/heap/store-buffer.cc \
-	v8/src/heap/sweeper-thread.cc \
 	v8/src/hydrogen-bce.cc \
 	v8/src/hydrogen-bch.cc \
 	v8/src/hydrogen-canonicalize.cc \